@@ -6,12 +6,12 @@
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EnhancedAsyncActionHandle)
 
 FEnhancedAsyncActionContextHandle::FEnhancedAsyncActionContextHandle()
-	: FAsyncContextHandleBase(FAsyncContextId(FAsyncContextId::InvalidValue))
+	: FAsyncContextHandleBase(FAsyncContextId())
 {
 }
 
-FEnhancedAsyncActionContextHandle::FEnhancedAsyncActionContextHandle(FAsyncContextId ContextId, TWeakObjectPtr<const UObject> Owner, TSharedRef<FEnhancedAsyncActionContext> Data)
-	: FAsyncContextHandleBase(ContextId, Owner, Data)
+FEnhancedAsyncActionContextHandle::FEnhancedAsyncActionContextHandle(FAsyncContextId ContextId, TWeakObjectPtr<const UObject> Owner)
+	: FAsyncContextHandleBase(ContextId, Owner)
 {
 }
 
@@ -3,7 +3,6 @@
 #pragma once
 
 #include "UObject/Object.h"
-#include "Templates/TypeHash.h"
 #include "EnhancedAsyncContextHandle.h"
 #include "EnhancedAsyncActionHandle.generated.h"
 
@@ -17,7 +16,7 @@ struct UE_API FEnhancedAsyncActionContextHandle : public FAsyncContextHandleBase
 
 public:
 	FEnhancedAsyncActionContextHandle();
-	FEnhancedAsyncActionContextHandle(FAsyncContextId ContextId, TWeakObjectPtr<const UObject> Owner, TSharedRef<FEnhancedAsyncActionContext> Data);
+	FEnhancedAsyncActionContextHandle(FAsyncContextId ContextId, TWeakObjectPtr<const UObject> Owner);
 
 	/** Shortcut to resolve context from manager */
 	TSharedPtr<FEnhancedAsyncActionContext> GetContext() const;
@@ -35,14 +34,4 @@ struct TStructOpsTypeTraits<FEnhancedAsyncActionContextHandle>
 	};
 };
 
-template <>
-inline FAsyncContextId FAsyncContextId::Make(const UObject* const& InObject)
-{
-#if WITH_CONTEXT_TYPE_TAG
-	return FAsyncContextId( ::PointerHash(InObject, INDEX_NONE), FAsyncContextId::EContextType::CT_AsyncAction );
-#else
-	return FAsyncContextId(::PointerHash(InObject, INDEX_NONE));
-#endif
-}
-
 #undef UE_API
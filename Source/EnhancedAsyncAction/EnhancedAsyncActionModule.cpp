@@ -2,5 +2,62 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "EnhancedAsyncContextManager.h"
+#include "EnhancedAsyncContextSettings.h"
+#include "EnhancedAsyncContextShared.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "UObject/UObjectGlobals.h"
 
-IMPLEMENT_MODULE(FDefaultModuleImpl, EnhancedAsyncAction)
+class FEnhancedAsyncActionModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override
+	{
+		FCoreDelegates::OnPostEngineInit.AddRaw(this, &FEnhancedAsyncActionModule::WarmUpContextLayouts);
+		FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FEnhancedAsyncActionModule::OnPostLoadMap);
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+		FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
+	}
+
+private:
+	void OnPostLoadMap(UWorld* World)
+	{
+		// layouts referencing types loaded with the map were not built at startup
+		WarmUpContextLayouts();
+	}
+
+	// Build context layouts listed in settings so first node calls do not resolve them during gameplay
+	void WarmUpContextLayouts()
+	{
+		const TArray<FString>& Definitions = UEnhancedAsyncContextSettings::Get()->GetWarmUpContextLayouts();
+		if (Definitions.IsEmpty() || !FEnhancedAsyncContextPool::IsEnabled())
+		{
+			return;
+		}
+
+		TRACE_CPUPROFILER_EVENT_SCOPE(FEnhancedAsyncActionModule::WarmUpContextLayouts);
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		FEnhancedAsyncContextPool& Pool = FEnhancedAsyncContextManager::Get().GetContextPool();
+
+		int32 NumBuilt = 0;
+		for (const FString& Definition : Definitions)
+		{
+			NumBuilt += Pool.WarmUpLayout(Definition) ? 1 : 0;
+		}
+
+		if (NumBuilt)
+		{
+			UE_LOG(LogEnhancedAction, Log, TEXT("Warmed up %d context layouts in %.2f ms"), NumBuilt, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+	}
+};
+
+IMPLEMENT_MODULE(FEnhancedAsyncActionModule, EnhancedAsyncAction)
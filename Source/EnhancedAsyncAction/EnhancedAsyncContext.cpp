@@ -3,13 +3,98 @@
 #include "EnhancedAsyncContext.h"
 
 #include "EnhancedAsyncContextShared.h"
+#include "EnhancedAsyncContextManager.h"
+#include "HAL/IConsoleManager.h"
+#include <atomic>
 
-bool FEnhancedAsyncActionContext::SetValueByIndex(int32 Index, const FProperty* Property, const void* Value, FString& Message)
+static std::atomic<int64> GContextAccessResults[static_cast<int32>(EContextAccessResult::Count)];
+
+static FAutoConsoleCommand GDumpContextAccessStatsCommand(
+	TEXT("EnhancedAsyncAction.DumpAccessStats"),
+	TEXT("Print context accessor failure counters"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		const FEnhancedAsyncActionContext::FAccessStats Stats = FEnhancedAsyncActionContext::GetAccessStats();
+		TStringBuilder<256> Builder;
+		for (int32 Index = 1; Index < static_cast<int32>(EContextAccessResult::Count); ++Index)
+		{
+			Builder.Appendf(TEXT(" %s=%lld"), LexToString(static_cast<EContextAccessResult>(Index)), Stats.Results[Index]);
+		}
+		UE_LOG(LogEnhancedAction, Display, TEXT("Context access failures:%s"), Builder.ToString());
+	})
+);
+
+const TCHAR* LexToString(EContextAccessResult Result)
+{
+	switch (Result)
+	{
+	case EContextAccessResult::Success: return TEXT("Success");
+	case EContextAccessResult::BadProperty: return TEXT("BadProperty");
+	case EContextAccessResult::UnknownProperty: return TEXT("UnknownProperty");
+	case EContextAccessResult::IncompatibleType: return TEXT("IncompatibleType");
+	case EContextAccessResult::MissingData: return TEXT("MissingData");
+	case EContextAccessResult::UnsupportedType: return TEXT("UnsupportedType");
+	default: return TEXT("Unknown");
+	}
+}
+
+EContextAccessResult FEnhancedAsyncActionContext::SetValueByIndex(int32 Index, const FProperty* Property, const void* Value)
+{
+	return SetValueByName(EAA::Internals::IndexToName(Index), Property, Value);
+}
+
+EContextAccessResult FEnhancedAsyncActionContext::GetValueByIndex(int32 Index, const FProperty* Property, void* OutValue)
+{
+	return GetValueByName(EAA::Internals::IndexToName(Index), Property, OutValue);
+}
+
+EContextAccessResult FEnhancedAsyncActionContext::ConsumeValueByIndex(int32 Index, const FProperty* Property, void* OutValue)
 {
-	return SetValueByName(EAA::Internals::IndexToName(Index), Property, Value, Message);
+	return GetValueByIndex(Index, Property, OutValue);
 }
 
-bool FEnhancedAsyncActionContext::GetValueByIndex(int32 Index, const FProperty* Property, void* OutValue, FString& Message)
+int64 FEnhancedAsyncActionContext::FAccessStats::GetNumFailures() const
 {
-	return GetValueByName(EAA::Internals::IndexToName(Index), Property, OutValue, Message);
+	int64 Total = 0;
+	for (int32 Index = 1; Index < static_cast<int32>(EContextAccessResult::Count); ++Index)
+	{
+		Total += Results[Index];
+	}
+	return Total;
 }
+
+void FEnhancedAsyncActionContext::RecordAccessFailure(EContextAccessResult Result)
+{
+	GContextAccessResults[static_cast<int32>(Result)].fetch_add(1, std::memory_order_relaxed);
+}
+
+FEnhancedAsyncActionContext::FAccessStats FEnhancedAsyncActionContext::GetAccessStats()
+{
+	FAccessStats Stats;
+	for (int32 Index = 0; Index < static_cast<int32>(EContextAccessResult::Count); ++Index)
+	{
+		Stats.Results[Index] = GContextAccessResults[Index].load(std::memory_order_relaxed);
+	}
+	return Stats;
+}
+
+FString FEnhancedAsyncActionContext::DescribeAccessResult(EContextAccessResult Result, const TCHAR* Operation, int32 Index, const FProperty* Property)
+{
+	const FString PropertyContainerString = UEnum::GetValueAsString(EAA::Internals::GetContainerTypeFromProperty(Property));
+	const FString PropertyTypeString = UEnum::GetValueAsString(EAA::Internals::GetValueTypeFromProperty(Property));
+	return FString::Printf(TEXT("Failed to %s context property at index %d (%s:%s) : %s"),
+		Operation, Index, *PropertyContainerString, *PropertyTypeString, LexToString(Result));
+}
+
+void FEnhancedAsyncActionContext::MarkHasObjectReferences()
+{
+	if (!bHasObjectReferences)
+	{
+		bHasObjectReferences = true;
+		const FAsyncContextId ContextId = RegisteredId.load(std::memory_order_acquire);
+		if (ContextId.IsValid())
+		{
+			FEnhancedAsyncContextManager::Get().NotifyContextReferencesAdded(ContextId);
+		}
+	}
+}
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "UObject/Class.h"
 #include "UObject/SoftObjectPtr.h"
 #include "EnhancedAsyncContextTypes.h"
+#include "EnhancedAsyncContextHandle.h"
+#include <atomic>
 
 #define UE_API ENHANCEDASYNCACTION_API
 
@@ -40,6 +42,30 @@
 	virtual void SetValue ##Name(int32 Index, EPropertyBagPropertyType Type, const UObject* TypeObject, const void* PropertyAddress) CONTEXT_PROPERTY_ACCESSOR_MODE; \
 	virtual void GetValue ##Name(int32 Index, EPropertyBagPropertyType Type, const UObject* TypeObject, void* PropertyAddress) CONTEXT_PROPERTY_ACCESSOR_MODE;
 
+/**
+ * Result of context value accessors.
+ *
+ * Failures are reported by code only, text is produced by DescribeAccessResult when an error is reported.
+ */
+enum class EContextAccessResult : uint8
+{
+	Success,
+	// null property, value or capture name
+	BadProperty,
+	// capture is not present in context
+	UnknownProperty,
+	// capture is stored with another type
+	IncompatibleType,
+	// capture is declared but has no value memory
+	MissingData,
+	// property type can not be captured
+	UnsupportedType,
+
+	Count
+};
+
+UE_API const TCHAR* LexToString(EContextAccessResult Result);
+
 /**
  * Async action context data container that is held by manager
  */
@@ -51,6 +77,14 @@ struct UE_API FEnhancedAsyncActionContext
 	virtual void SetupFromStringDefinition(const FString& InDefinition) {}
 	virtual void SetupFromProperties(TConstArrayView<TPair<FName, const FProperty*>> Properties) {}
 
+	/**
+	 * Collect captures that are missing in value layout instead of adding them one by one.
+	 * Staged values become readable after commit.
+	 */
+	virtual void BeginStaging() {}
+	/** Add staged captures to value layout at once and write their values */
+	virtual void CommitStaging() {}
+
 	virtual const UObject* GetOwningObject() const { return nullptr; }
 	virtual bool IsValid() const = 0;
 	virtual void AddReferencedObjects(FReferenceCollector& Collector) {}
@@ -76,18 +110,55 @@ struct UE_API FEnhancedAsyncActionContext
 	CONTEXT_DECLARE_CONTAINER_ACCESSOR(Set)
 #undef CONTEXT_PROPERTY_ACCESSOR_MODE
 
-	bool SetValueByIndex(int32 Index, const FProperty* Property, const void* Value, FString& Message);
-	virtual bool SetValueByName(FName Name, const FProperty* Property, const void* Value, FString& Message) =0;
+	virtual EContextAccessResult SetValueByIndex(int32 Index, const FProperty* Property, const void* Value);
+	virtual EContextAccessResult SetValueByName(FName Name, const FProperty* Property, const void* Value) =0;
+
+	virtual EContextAccessResult GetValueByIndex(int32 Index, const FProperty* Property, void* OutValue);
+	// Final read of value, storage of strings and containers may be moved out leaving context value unspecified
+	virtual EContextAccessResult ConsumeValueByIndex(int32 Index, const FProperty* Property, void* OutValue);
+	virtual EContextAccessResult GetValueByName(FName Name, const FProperty* Property, void* OutValue) =0;
 
-	bool GetValueByIndex(int32 Index, const FProperty* Property, void* OutValue, FString& Message);
-	virtual bool GetValueByName(FName Name, const FProperty* Property, void* OutValue, FString& Message) =0;
+	/** Counters of failed accessor results reported by callers since startup, successes are not counted */
+	struct FAccessStats
+	{
+		int64 Results[static_cast<int32>(EContextAccessResult::Count)] = { };
+
+		int64 GetNumFailures() const;
+	};
+
+	/** Count failed accessor result, safe to call from any thread, success only costs a compare */
+	static void RecordAccessResult(EContextAccessResult Result)
+	{
+		if (UNLIKELY(Result != EContextAccessResult::Success))
+		{
+			RecordAccessFailure(Result);
+		}
+	}
+	static FAccessStats GetAccessStats();
+
+	static FORCENOINLINE void RecordAccessFailure(EContextAccessResult Result);
+
+	/** Format failed access for logs and script exceptions, only called on error path */
+	static FString DescribeAccessResult(EContextAccessResult Result, const TCHAR* Operation, int32 Index, const FProperty* Property);
 
 	bool CanAddReferencedObjects() const { return bAddReferencedObjectsAllowed; }
 	bool CanSetupContext() const { return bSetupContextAllowed; }
+	bool CanRecycle() const { return bRecycleAllowed; }
+	bool HasObjectReferences() const { return bHasObjectReferences; }
 
 protected:
+	// Flag context as holding object references so manager starts reporting it to garbage collection
+	void MarkHasObjectReferences();
+
 	bool bAddReferencedObjectsAllowed = true;
 	bool bSetupContextAllowed = true;
+	bool bRecycleAllowed = false;
+	bool bHasObjectReferences = false;
+
+	// Identifier the context is registered with, set by manager under shard lock and read by game thread resolve without it
+	std::atomic<FAsyncContextId> RegisteredId { FAsyncContextId() };
+
+	friend class FEnhancedAsyncContextManager;
 };
 
 #undef UE_API
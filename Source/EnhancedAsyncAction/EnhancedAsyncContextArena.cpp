@@ -0,0 +1,323 @@
+﻿// Copyright 2025, Aquanox.
+
+#include "EnhancedAsyncContextArena.h"
+
+#include "EnhancedAsyncContextManager.h"
+#include "EnhancedAsyncContextSettings.h"
+#include "EnhancedAsyncContextShared.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+#include <atomic>
+
+static FAutoConsoleCommand GDumpContextArenaStatsCommand(
+	TEXT("EnhancedAsyncAction.DumpArenaStats"),
+	TEXT("Print context arena occupancy and heap fallback counters"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		const FEnhancedAsyncContextArena::FStats Stats = FEnhancedAsyncContextManager::Get().GetArenaStats();
+		UE_LOG(LogEnhancedAction, Display, TEXT("Context arena: used=%lld/%lld bytes live=%d pages=%d free=%d spilled=%d, allocations=%lld fallbacks=%lld spills=%lld"),
+			Stats.UsedBytes, Stats.CapacityBytes, Stats.NumLiveBlocks, Stats.NumPages, Stats.NumFreePages, Stats.NumSpilledPages,
+			Stats.NumAllocations, Stats.NumFallbacks, Stats.NumSpills);
+	})
+);
+
+// Keeps arenas alive while a released block is returned to its page, taken exclusively by arena destructor
+static FRWLock GArenaTeardownLock;
+
+struct FEnhancedAsyncContextArena::FPage
+{
+	// Null once owning arena is destroyed, guarded by GArenaTeardownLock
+	FEnhancedAsyncContextArena* Arena = nullptr;
+	// Frame the page was opened at
+	uint64 OpenFrame = 0;
+	uint32 Size = 0;
+	// Bump offset from page start
+	uint32 Offset = 0;
+	std::atomic<int32> NumLive { 0 };
+	bool bSpilled = false;
+
+	uint8* GetBase() { return reinterpret_cast<uint8*>(this); }
+
+	void Reset(uint64 Frame)
+	{
+		OpenFrame = Frame;
+		Offset = sizeof(FPage);
+	}
+
+	// Each block is preceded by pointer to its page
+	static FPage*& GetBlockPage(void* Memory) { return *(static_cast<FPage**>(Memory) - 1); }
+};
+
+FEnhancedAsyncContextArena::FStats& FEnhancedAsyncContextArena::FStats::operator+=(const FStats& Other)
+{
+	NumAllocations += Other.NumAllocations;
+	NumFallbacks += Other.NumFallbacks;
+	NumSpills += Other.NumSpills;
+	UsedBytes += Other.UsedBytes;
+	CapacityBytes += Other.CapacityBytes;
+	NumLiveBlocks += Other.NumLiveBlocks;
+	NumPages += Other.NumPages;
+	NumFreePages += Other.NumFreePages;
+	NumSpilledPages += Other.NumSpilledPages;
+	return *this;
+}
+
+FEnhancedAsyncContextArena::~FEnhancedAsyncContextArena()
+{
+	// no block of this arena is being released while pages are detached
+	FWriteScopeLock TeardownLock(GArenaTeardownLock);
+	FScopeLock Lock(&CriticalSection);
+
+	auto ReleasePage = [](FPage* Page)
+	{
+		if (Page->NumLive.load(std::memory_order_acquire) == 0)
+		{
+			FMemory::Free(Page);
+		}
+		else
+		{ // freed with its last context
+			Page->Arena = nullptr;
+		}
+	};
+
+	if (OpenPage)
+	{
+		ReleasePage(OpenPage);
+		OpenPage = nullptr;
+	}
+	for (FPage* Page : RetiredPages)
+	{
+		ReleasePage(Page);
+	}
+	for (FPage* Page : SpilledPages)
+	{
+		ReleasePage(Page);
+	}
+	for (FPage* Page : FreePages)
+	{
+		FMemory::Free(Page);
+	}
+}
+
+bool FEnhancedAsyncContextArena::IsEnabledForClass(const UClass* Class)
+{
+	return UEnhancedAsyncContextSettings::Get()->IsContextArenaEnabledForClass(Class);
+}
+
+void* FEnhancedAsyncContextArena::Allocate(SIZE_T Size, uint32 Alignment)
+{
+	const UEnhancedAsyncContextSettings* Settings = UEnhancedAsyncContextSettings::Get();
+	const uint32 PageSize = Settings->GetContextArenaPageSize();
+	const uint32 SpillFrames = Settings->GetContextArenaSpillFrames();
+	const uint64 Frame = GFrameCounter;
+
+	Alignment = FMath::Max<uint32>(Alignment, alignof(FPage*));
+
+	auto TryAllocate = [Size, Alignment](FPage* Page) -> void*
+	{
+		const UPTRINT Base = reinterpret_cast<UPTRINT>(Page->GetBase());
+		const UPTRINT Block = Align(Base + Page->Offset + sizeof(FPage*), Alignment);
+		if (Block + Size > Base + Page->Size)
+		{
+			return nullptr;
+		}
+
+		Page->Offset = static_cast<uint32>(Block + Size - Base);
+		Page->NumLive.fetch_add(1, std::memory_order_relaxed);
+		FPage::GetBlockPage(reinterpret_cast<void*>(Block)) = Page;
+		return reinterpret_cast<void*>(Block);
+	};
+
+	FScopeLock Lock(&CriticalSection);
+
+	if (sizeof(FPage) + sizeof(FPage*) + Alignment + Size > PageSize)
+	{
+		++NumFallbacks;
+		return nullptr;
+	}
+
+	// open page is kept while it is young, so long-lived contexts do not pin pages of fresh ones
+	if (OpenPage && Frame - OpenPage->OpenFrame <= SpillFrames)
+	{
+		if (void* Memory = TryAllocate(OpenPage))
+		{
+			++NumLiveBlocks;
+			++NumAllocations;
+			return Memory;
+		}
+	}
+
+	if (OpenPage)
+	{
+		if (OpenPage->NumLive.load(std::memory_order_relaxed) == 0)
+		{
+			FreePages.Add(OpenPage);
+		}
+		else
+		{
+			RetiredPages.Add(OpenPage);
+		}
+		OpenPage = nullptr;
+	}
+
+	// page size may have changed in settings, pages of other size are dropped
+	while (!FreePages.IsEmpty() && OpenPage == nullptr)
+	{
+		FPage* Page = FreePages.Pop(EAllowShrinking::No);
+		if (Page->Size == PageSize)
+		{
+			OpenPage = Page;
+		}
+		else
+		{
+			FMemory::Free(Page);
+		}
+	}
+
+	if (OpenPage == nullptr)
+	{
+		const int32 MaxPages = Settings->GetMaxContextArenaPages();
+		if (RetiredPages.Num() >= MaxPages)
+		{
+			SpillStalePages(Frame, SpillFrames);
+		}
+
+		if (RetiredPages.Num() >= MaxPages)
+		{
+			++NumFallbacks;
+			return nullptr;
+		}
+
+		OpenPage = new (FMemory::Malloc(PageSize, alignof(FPage))) FPage();
+		OpenPage->Arena = this;
+		OpenPage->Size = PageSize;
+	}
+
+	OpenPage->Reset(Frame);
+
+	void* Memory = TryAllocate(OpenPage);
+	check(Memory != nullptr);
+	++NumLiveBlocks;
+	++NumAllocations;
+	return Memory;
+}
+
+void FEnhancedAsyncContextArena::Free(void* Memory)
+{
+	if (Memory == nullptr)
+	{
+		return;
+	}
+
+	// page memory stays valid until this block is counted out, arena only while teardown lock is held
+	FPage* Page = FPage::GetBlockPage(Memory);
+	FReadScopeLock TeardownLock(GArenaTeardownLock);
+	if (FEnhancedAsyncContextArena* Arena = Page->Arena)
+	{
+		Arena->ReleaseBlock(Page);
+	}
+	else if (Page->NumLive.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{ // page outlived its arena
+		FMemory::Free(Page);
+	}
+}
+
+void FEnhancedAsyncContextArena::ReleaseBlock(FPage* Page)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	--NumLiveBlocks;
+	if (Page->NumLive.fetch_sub(1, std::memory_order_relaxed) != 1)
+	{
+		return;
+	}
+
+	if (Page == OpenPage)
+	{ // all contexts of open page are released, its memory is reused right away
+		Page->Reset(GFrameCounter);
+		return;
+	}
+
+	if (Page->bSpilled)
+	{
+		SpilledPages.RemoveSingleSwap(Page, EAllowShrinking::No);
+		FMemory::Free(Page);
+	}
+	else
+	{
+		RetiredPages.RemoveSingleSwap(Page, EAllowShrinking::No);
+		FreePages.Add(Page);
+	}
+}
+
+bool FEnhancedAsyncContextArena::SpillStalePages(uint64 Frame, uint32 SpillFrames)
+{
+	bool bSpilled = false;
+	for (int32 Index = RetiredPages.Num() - 1; Index >= 0; --Index)
+	{
+		FPage* Page = RetiredPages[Index];
+		if (Frame - Page->OpenFrame > SpillFrames)
+		{
+			Page->bSpilled = true;
+			SpilledPages.Add(Page);
+			RetiredPages.RemoveAtSwap(Index, EAllowShrinking::No);
+			++NumSpills;
+			bSpilled = true;
+		}
+	}
+	return bSpilled;
+}
+
+void FEnhancedAsyncContextArena::Trim()
+{
+	TArray<FPage*> Pages;
+	{
+		FScopeLock Lock(&CriticalSection);
+		Pages = MoveTemp(FreePages);
+		if (OpenPage && OpenPage->NumLive.load(std::memory_order_relaxed) == 0)
+		{
+			Pages.Add(OpenPage);
+			OpenPage = nullptr;
+		}
+	}
+
+	for (FPage* Page : Pages)
+	{
+		FMemory::Free(Page);
+	}
+}
+
+FEnhancedAsyncContextArena::FStats FEnhancedAsyncContextArena::GetStats() const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	FStats Stats;
+	Stats.NumAllocations = NumAllocations;
+	Stats.NumFallbacks = NumFallbacks;
+	Stats.NumSpills = NumSpills;
+	Stats.NumLiveBlocks = NumLiveBlocks;
+	Stats.NumFreePages = FreePages.Num();
+	Stats.NumSpilledPages = SpilledPages.Num();
+
+	auto AddPage = [&Stats](const FPage* Page, bool bUsed)
+	{
+		++Stats.NumPages;
+		Stats.CapacityBytes += Page->Size;
+		Stats.UsedBytes += bUsed ? Page->Offset : 0;
+	};
+
+	if (OpenPage)
+	{
+		AddPage(OpenPage, true);
+	}
+	for (const FPage* Page : RetiredPages)
+	{
+		AddPage(Page, true);
+	}
+	for (const FPage* Page : FreePages)
+	{
+		AddPage(Page, false);
+	}
+	return Stats;
+}
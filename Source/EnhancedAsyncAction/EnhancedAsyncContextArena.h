@@ -0,0 +1,105 @@
+﻿// Copyright 2025, Aquanox.
+
+#pragma once
+
+#include "HAL/CriticalSection.h"
+#include "Templates/SharedPointer.h"
+
+#define UE_API ENHANCEDASYNCACTION_API
+
+class UClass;
+
+/**
+ * Frame tagged page arena for short-lived context objects of one world.
+ *
+ * Blocks are bump allocated from the open page and never freed one by one,
+ * a page is reclaimed in bulk once every context allocated from it is released.
+ * Pages still holding contexts after configured number of frames are detached from the arena budget
+ * and returned to the heap with their last context, new contexts fall back to the heap when the budget is exhausted.
+ */
+class UE_API FEnhancedAsyncContextArena
+{
+public:
+	struct FStats
+	{
+		int64 NumAllocations = 0;
+		int64 NumFallbacks = 0;
+		int64 NumSpills = 0;
+		int64 UsedBytes = 0;
+		int64 CapacityBytes = 0;
+		int32 NumLiveBlocks = 0;
+		int32 NumPages = 0;
+		int32 NumFreePages = 0;
+		int32 NumSpilledPages = 0;
+
+		FStats& operator+=(const FStats& Other);
+	};
+
+	FEnhancedAsyncContextArena() = default;
+	~FEnhancedAsyncContextArena();
+	FEnhancedAsyncContextArena(const FEnhancedAsyncContextArena&) = delete;
+	FEnhancedAsyncContextArena& operator=(const FEnhancedAsyncContextArena&) = delete;
+
+	/** Are contexts of owner class opted into arena allocation in project settings */
+	static bool IsEnabledForClass(const UClass* Class);
+
+	/**
+	 * Construct context in arena memory, or on the heap if arena is null or has no room
+	 */
+	template<typename T, typename... TArgs>
+	static TSharedRef<T> MakeContext(FEnhancedAsyncContextArena* Arena, TArgs&&... Args)
+	{
+		void* Memory = Arena ? Arena->Allocate(sizeof(T), alignof(T)) : nullptr;
+		if (Memory == nullptr)
+		{
+			return MakeShared<T>(Forward<TArgs>(Args)...);
+		}
+
+		return MakeShareable(new (Memory) T(Forward<TArgs>(Args)...), [](T* Object)
+		{
+			Object->~T();
+			FEnhancedAsyncContextArena::Free(Object);
+		});
+	}
+
+	/**
+	 * Allocate block from the open page
+	 *
+	 * @return null if block does not fit into a page or page budget is exhausted
+	 */
+	void* Allocate(SIZE_T Size, uint32 Alignment);
+
+	/** Release block allocated by any arena */
+	static void Free(void* Memory);
+
+	/** Return unused pages to the heap */
+	void Trim();
+
+	FStats GetStats() const;
+
+private:
+	struct FPage;
+
+	// Release block of a page owned by this arena
+	void ReleaseBlock(FPage* Page);
+	// Detach pages holding contexts older than spill threshold from the budget
+	bool SpillStalePages(uint64 Frame, uint32 SpillFrames);
+
+	mutable FCriticalSection CriticalSection;
+
+	// Page new blocks are allocated from
+	FPage* OpenPage = nullptr;
+	// Filled pages waiting for their contexts to be released
+	TArray<FPage*> RetiredPages;
+	// Pages detached from the budget, freed with their last context
+	TArray<FPage*> SpilledPages;
+	// Reclaimed pages ready to be opened
+	TArray<FPage*> FreePages;
+
+	int32 NumLiveBlocks = 0;
+	int64 NumAllocations = 0;
+	int64 NumFallbacks = 0;
+	int64 NumSpills = 0;
+};
+
+#undef UE_API
@@ -9,12 +9,12 @@ FAsyncContextHandleBase::FAsyncContextHandleBase(const FAsyncContextId& Id)
 }
 
 FAsyncContextHandleBase::FAsyncContextHandleBase(const FAsyncContextHandleBase& Other)
-	: ContextId(Other.ContextId), Owner(Other.Owner), Data(Other.Data)
+	: ContextId(Other.ContextId), Owner(Other.Owner)
 {
 }
 
-FAsyncContextHandleBase::FAsyncContextHandleBase(const FAsyncContextId& Id, TWeakObjectPtr<const UObject> Owner, TSharedRef<FEnhancedAsyncActionContext> Data)
-	: ContextId(Id), Owner(Owner), Data(Data)
+FAsyncContextHandleBase::FAsyncContextHandleBase(const FAsyncContextId& Id, TWeakObjectPtr<const UObject> Owner)
+	: ContextId(Id), Owner(Owner)
 {
 }
 
@@ -25,5 +25,5 @@ const FAsyncContextId& FAsyncContextHandleBase::GetId() const
 
 bool FAsyncContextHandleBase::IsValid() const
 {
-	return static_cast<bool>(ContextId) && Owner.IsValid() && Data.IsValid();
+	return static_cast<bool>(ContextId) && Owner.IsValid();
 }
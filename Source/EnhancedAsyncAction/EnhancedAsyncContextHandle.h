@@ -5,12 +5,13 @@
 #include "UObject/Object.h"
 #include "UObject/WeakObjectPtr.h"
 #include "Templates/SharedPointer.h"
+#include "Templates/TypeHash.h"
 #include "EnhancedAsyncContextHandle.generated.h"
 
 #define UE_API ENHANCEDASYNCACTION_API
 
-// Experiment with packed identifier - reserve two lowest bits for handle type
-#define WITH_CONTEXT_TYPE_TAG 0
+// Reserve two lowest bits of identifier serial for handle type
+#define WITH_CONTEXT_TYPE_TAG 1
 
 struct FEnhancedAsyncActionContext;
 
@@ -25,7 +26,10 @@ enum class EResolveErrorMode
 };
 
 /**
- * Unique identifier to context for async and latent actions
+ * Unique identifier to context for async and latent actions.
+ *
+ * Identifier is a generational handle into context manager slot storage: index addresses the slot,
+ * serial is the slot generation at the moment of registration and detects stale identifiers after slot reuse.
  */
 struct UE_API FAsyncContextId
 {
@@ -39,53 +43,62 @@ public:
 		CT_LatentAction = 2,
 
 		CT_SHIFT = 2,
-		CT_MASK = 1 << CT_SHIFT
+		CT_MASK = (1 << CT_SHIFT) - 1
 	};
 #endif
 
+	FAsyncContextId() = default;
+
 #if WITH_CONTEXT_TYPE_TAG
-	explicit FAsyncContextId(uint32 InValue = InvalidValue, EContextType InType = EContextType::CT_Unknown) : Value(InValue)
+	FAsyncContextId(uint32 InIndex, uint32 InGeneration, EContextType InType)
+		: Index(InIndex), Serial((InGeneration << CT_SHIFT) | (uint32)InType)
 	{
-		Value = (InValue << CT_SHIFT) | (uint32)InType;
 	}
 #else
-	explicit FAsyncContextId(uint32 InValue = InvalidValue) : Value(InValue) {}
+	FAsyncContextId(uint32 InIndex, uint32 InGeneration)
+		: Index(InIndex), Serial(InGeneration)
+	{
+	}
 #endif
 
-	bool operator<(const FAsyncContextId& Other) const { return Value < Other.Value; }
-	bool operator==(const FAsyncContextId& Other) const { return Value == Other.Value; }
+	bool operator<(const FAsyncContextId& Other) const { return Index != Other.Index ? Index < Other.Index : Serial < Other.Serial; }
+	bool operator==(const FAsyncContextId& Other) const { return Index == Other.Index && Serial == Other.Serial; }
 	bool operator!=(const FAsyncContextId& Other) const { return !operator==(Other); }
 
-	explicit operator bool() const { return Value != InvalidValue; }
-	explicit operator uint32() const { return Value; }
+	explicit operator bool() const { return Index != InvalidValue; }
+
+	bool IsValid() const { return Index != InvalidValue; }
 
-	bool IsValid() const { return Value != InvalidValue; }
+	/** Slot index within context manager storage */
+	uint32 GetIndex() const { return Index; }
 
 #if WITH_CONTEXT_TYPE_TAG
-	bool IsA(EContextType InType) const { return (Value & CT_MASK) == InType; }
+	/** Slot generation this identifier was issued for */
+	uint32 GetGeneration() const { return Serial >> CT_SHIFT; }
+
+	bool IsA(EContextType InType) const { return (Serial & CT_MASK) == InType; }
+#else
+	/** Slot generation this identifier was issued for */
+	uint32 GetGeneration() const { return Serial; }
 #endif
 
-	friend uint32 GetTypeHash(const FAsyncContextId& Id)
+	FString ToString() const
 	{
-		return Id.Value;
+		return IsValid() ? FString::Printf(TEXT("%u:%u"), Index, Serial) : FString(TEXT("None"));
 	}
 
-	/**
-	 * Make identifier matching given parameters
-	 */
-	template<typename T>
-	static FAsyncContextId Make(T const&) = delete;
+	friend uint32 GetTypeHash(const FAsyncContextId& Id)
+	{
+		return HashCombineFast(Id.Index, Id.Serial);
+	}
 
 private:
 	friend class FEnhancedAsyncContextManager;
 
-	// The unique context identifier value
-	uint32 Value;
-
-#if WITH_CONTEXT_TYPE_TAG
-	// The handle type
-	EContextType Type = EContextType::CT_Unknown;
-#endif
+	// Slot index
+	uint32 Index = InvalidValue;
+	// Slot generation, with handle type in lowest bits
+	uint32 Serial = 0;
 };
 
 /**
@@ -99,23 +112,22 @@ public:
 	FAsyncContextHandleBase() = default; // for bp use
 	explicit FAsyncContextHandleBase(const FAsyncContextId& Id);
 	explicit FAsyncContextHandleBase(const FAsyncContextHandleBase& Other);
-	FAsyncContextHandleBase(const FAsyncContextId& Id, TWeakObjectPtr<const UObject> Owner, TSharedRef<FEnhancedAsyncActionContext> Data);
+	FAsyncContextHandleBase(const FAsyncContextId& Id, TWeakObjectPtr<const UObject> Owner);
 
 	/** Get identifier for this context handle */
 	const FAsyncContextId& GetId() const;
-	/** Is handle valid (has valid owning object and data) */
+	/** Is handle valid (has valid identifier and owning object) */
 	bool IsValid() const;
 
 	FString GetDebugString() const
 	{
-		return FString::Printf(TEXT("Id=%x Owner=%s"), (uint32)GetId(), *GetNameSafe(Owner.GetEvenIfUnreachable()));
+		return FString::Printf(TEXT("Id=%s Owner=%s"), *GetId().ToString(), *GetNameSafe(Owner.GetEvenIfUnreachable()));
 	}
 protected:
 	friend class FEnhancedAsyncContextManager;
 
 	FAsyncContextId ContextId;
 	TWeakObjectPtr<const UObject> Owner;
-	TWeakPtr<FEnhancedAsyncActionContext> Data;
 };
 
 template<>
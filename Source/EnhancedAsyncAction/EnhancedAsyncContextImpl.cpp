@@ -2,9 +2,15 @@
 
 #include "EnhancedAsyncContextImpl.h"
 #include "EnhancedAsyncContextShared.h"
+#include "EnhancedAsyncContextLayout.h"
+#include "EnhancedAsyncContextManager.h"
+#include "EnhancedAsyncContextPool.h"
+#include "EnhancedAsyncContextSettings.h"
 #include "EdGraph/EdGraphPin.h"
 #include "EdGraph/EdGraphSchema.h"
 #include "Misc/DefinePrivateMemberPtr.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/GCObject.h"
 
 
 UE_DEFINE_PRIVATE_MEMBER_PTR(FPropertyBagPropertyDesc, GPropertyBagArrayRef_Desc, FPropertyBagArrayRef, ValueDesc);
@@ -95,6 +101,69 @@ namespace EAA::Internals
 			}
 		}
 	}
+
+	// Plain data pairs are copied as raw blocks into storage reserved up front, only hashes are rebuilt
+	static void CopyMapValue(const FMapProperty* Property, void* Dest, const void* Src)
+	{
+		const FProperty* KeyProp = Property->KeyProp;
+		const FProperty* ValueProp = Property->ValueProp;
+		if (Dest == Src || !KeyProp->HasAnyPropertyFlags(CPF_IsPlainOldData) || !ValueProp->HasAnyPropertyFlags(CPF_IsPlainOldData))
+		{
+			Property->CopyCompleteValue(Dest, Src);
+			return;
+		}
+
+		FScriptMapHelper SrcHelper(Property, Src);
+		FScriptMapHelper DestHelper(Property, Dest);
+		const FScriptMapLayout MapLayout = FScriptMap::GetScriptLayout(
+			KeyProp->GetElementSize(), KeyProp->GetMinAlignment(), ValueProp->GetElementSize(), ValueProp->GetMinAlignment());
+		const int32 PairSize = MapLayout.ValueOffset + ValueProp->GetElementSize();
+
+		DestHelper.EmptyValues(SrcHelper.Num());
+		for (int32 Index = 0, Max = SrcHelper.GetMaxIndex(); Index < Max; ++Index)
+		{
+			if (!SrcHelper.IsValidIndex(Index))
+				continue;
+			const int32 NewIndex = DestHelper.AddUninitializedValue();
+			FMemory::Memcpy(DestHelper.GetPairPtrWithoutCheck(NewIndex), SrcHelper.GetPairPtrWithoutCheck(Index), PairSize);
+		}
+		DestHelper.Rehash();
+	}
+
+	// Only direct object keys and values are reported, nested references need a reflected owner
+	static bool CanCaptureMap(const FMapProperty* Property)
+	{
+		for (const FProperty* Inner : { Property->KeyProp, Property->ValueProp })
+		{
+			TArray<const FStructProperty*> EncounteredStructProps;
+			if (Inner->ContainsObjectReference(EncounteredStructProps, EPropertyObjectReferenceType::Strong) && !CastField<FObjectProperty>(Inner))
+				return false;
+		}
+		return true;
+	}
+
+	static void AddMapReferencedObjects(const FMapProperty* Property, void* Memory, FReferenceCollector& Collector)
+	{
+		const bool bObjectKey = CastField<FObjectProperty>(Property->KeyProp) != nullptr;
+		const bool bObjectValue = CastField<FObjectProperty>(Property->ValueProp) != nullptr;
+		if (!bObjectKey && !bObjectValue)
+			return;
+
+		FScriptMapHelper Helper(Property, Memory);
+		for (int32 Index = 0, Max = Helper.GetMaxIndex(); Index < Max; ++Index)
+		{
+			if (!Helper.IsValidIndex(Index))
+				continue;
+			if (bObjectKey)
+			{
+				Collector.AddReferencedObject(*reinterpret_cast<TObjectPtr<UObject>*>(Helper.GetKeyPtr(Index)));
+			}
+			if (bObjectValue)
+			{
+				Collector.AddReferencedObject(*reinterpret_cast<TObjectPtr<UObject>*>(Helper.GetValuePtr(Index)));
+			}
+		}
+	}
 }
 
 // ==============================================
@@ -106,7 +175,414 @@ inline class FFrieldlyInstancedPropertyBag* FEnhancedAsyncActionContext_Property
 
 void FEnhancedAsyncActionContext_PropertyBagBase::AddReferencedObjects(FReferenceCollector& Collector)
 {
-	GetValueRef()->AddStructReferencedObjects(Collector);
+	for (FSharedCapture& Shared : SharedCaptures)
+	{
+		Shared.Payload->Value.AddStructReferencedObjects(Collector);
+	}
+
+	for (FMapCapture& Capture : MapCaptures)
+	{
+		Collector.AddReferencedObject(Capture.PropertyOwner);
+		EAA::Internals::AddMapReferencedObjects(Capture.Property, Capture.Memory, Collector);
+	}
+
+	FFrieldlyInstancedPropertyBag* Bag = GetValueRef();
+	if (Layout.IsValid() && Layout->GetStruct() == Bag->GetPropertyBagStruct())
+	{
+		// value memory is laid out by the struct, it must outlive the value even if properties are skipped
+		const UPropertyBag* Struct = Bag->GetPropertyBagStruct();
+		Collector.AddReferencedObject(Struct);
+
+		if (!Layout->HasObjectReferences() || Layout->AddReferencedObjects(Bag->GetMutableValue().GetMemory(), Collector))
+		{
+			return;
+		}
+	}
+	// layout is unknown or has nested references
+	Bag->AddStructReferencedObjects(Collector);
+}
+
+void FEnhancedAsyncActionContext_PropertyBagBase::RefreshLayout()
+{
+	const UPropertyBag* Struct = GetValueRef()->GetPropertyBagStruct();
+	if (Layout.IsValid() && Layout->GetStruct() == Struct)
+		return;
+
+	Layout = FEnhancedAsyncContextLayout::FindOrAdd(Struct);
+	if (Layout.IsValid() && Layout->HasObjectReferences())
+	{
+		MarkHasObjectReferences();
+	}
+}
+
+const FEnhancedAsyncContextLayout::FSlot* FEnhancedAsyncActionContext_PropertyBagBase::FindLayoutSlot(int32 Index) const
+{
+	// value of a referenced bag may be restructured outside of context
+	if (Layout.IsValid() && Layout->GetStruct() == GetValueRef()->GetPropertyBagStruct())
+	{
+		return Layout->FindSlot(Index);
+	}
+	return nullptr;
+}
+
+uint8* FEnhancedAsyncActionContext_PropertyBagBase::GetSlotMemory(const FEnhancedAsyncContextLayout::FSlot& Slot) const
+{
+	return GetValueRef()->GetMutableValue().GetMemory() + Slot.Offset;
+}
+
+template <typename T>
+T* FEnhancedAsyncActionContext_PropertyBagBase::FindSlotValue(int32 Index, EPropertyBagPropertyType Type, const UObject* TypeObject) const
+{
+	const FEnhancedAsyncContextLayout::FSlot* Slot = FindLayoutSlot(Index);
+	if (Slot && Slot->Matches(Type, TypeObject))
+	{
+		return reinterpret_cast<T*>(GetSlotMemory(*Slot));
+	}
+	return nullptr;
+}
+
+/**
+ * Immutable copy of a large capture value referenced by several contexts
+ */
+struct FEnhancedAsyncSharedCapture
+{
+	~FEnhancedAsyncSharedCapture();
+
+	// Single property bag owning the value
+	FInstancedPropertyBag Value;
+	const FProperty* Property = nullptr;
+	uint8* Memory = nullptr;
+	// Cache entry of the payload, removed with its last reference
+	const FProperty* SourceProperty = nullptr;
+	uint32 Hash = 0;
+};
+
+/**
+ * Live payloads keyed by capture slot property and value hash.
+ *
+ * Fan-out loops pass the same value to every spawned action, a hash hit is confirmed by comparing values.
+ * Entries and payload bag structs are dropped once the last context referencing them releases the payload.
+ * Payloads are made on game thread only, but may be released from any thread.
+ */
+struct FEnhancedAsyncSharedCaptureCache : public FGCObject
+{
+	// Structs smaller than that are cheaper to copy than to compare and share
+	static constexpr int32 MinSharedStructSize = 64;
+	// Live payloads kept at most, values captured beyond that are copied
+	static constexpr int32 MaxEntries = 1024;
+
+	using FKey = TPair<const FProperty*, uint32>;
+
+	mutable FCriticalSection CriticalSection;
+	TMap<FKey, TWeakPtr<FEnhancedAsyncSharedCapture>> Entries;
+	// Bag structs of live payloads with their payload count
+	TMap<const UPropertyBag*, int32> PayloadStructs;
+
+	static FEnhancedAsyncSharedCaptureCache& Get()
+	{
+		static FEnhancedAsyncSharedCaptureCache Instance;
+		return Instance;
+	}
+
+	static bool CanShare(const FProperty* Property)
+	{
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			return IsHashable(ArrayProperty->Inner);
+		}
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		return StructProperty && StructProperty->Struct && StructProperty->Struct->GetStructureSize() >= MinSharedStructSize
+			&& IsHashable(StructProperty);
+	}
+
+	static bool IsHashable(const FProperty* Property)
+	{
+		return Property->HasAnyPropertyFlags(CPF_HasGetValueTypeHash | CPF_IsPlainOldData);
+	}
+
+	static uint32 HashValue(const FProperty* Property, const void* Value)
+	{
+		if (Property->HasAnyPropertyFlags(CPF_HasGetValueTypeHash))
+		{
+			return Property->GetValueTypeHash(Value);
+		}
+		return FCrc::MemCrc32(Value, Property->GetElementSize());
+	}
+
+	// Hash of capture value, values of shareable properties only
+	static uint32 HashCapture(const FProperty* Property, const void* Value)
+	{
+		const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property);
+		if (ArrayProperty == nullptr)
+		{
+			return HashValue(Property, Value);
+		}
+
+		FScriptArrayHelper Helper(ArrayProperty, Value);
+		const FProperty* Inner = ArrayProperty->Inner;
+		if (!Inner->HasAnyPropertyFlags(CPF_HasGetValueTypeHash))
+		{
+			return FCrc::MemCrc32(Helper.GetRawPtr(), Helper.Num() * Inner->GetElementSize(), Helper.Num());
+		}
+
+		uint32 Hash = GetTypeHash(Helper.Num());
+		for (int32 Index = 0; Index < Helper.Num(); ++Index)
+		{
+			Hash = HashCombineFast(Hash, Inner->GetValueTypeHash(Helper.GetRawPtr(Index)));
+		}
+		return Hash;
+	}
+
+	TSharedPtr<FEnhancedAsyncSharedCapture> FindOrAdd(const FEnhancedAsyncContextLayout::FSlot& Slot, const void* Value)
+	{
+		const FKey Key(Slot.Property, HashCapture(Slot.Property, Value));
+
+		FScopeLock Lock(&CriticalSection);
+
+		TWeakPtr<FEnhancedAsyncSharedCapture>* Entry = Entries.Find(Key);
+		if (Entry)
+		{
+			TSharedPtr<FEnhancedAsyncSharedCapture> Payload = Entry->Pin();
+			if (Payload.IsValid() && Slot.Property->Identical(Payload->Memory, Value, PPF_None))
+			{
+				return Payload;
+			}
+		}
+		else if (Entries.Num() >= MaxEntries)
+		{
+			return nullptr;
+		}
+
+		static const FName PayloadName(TEXT("Value"));
+
+		TSharedPtr<FEnhancedAsyncSharedCapture> Payload = MakeShared<FEnhancedAsyncSharedCapture>();
+		Payload->Value.AddProperties({ FPropertyBagPropertyDesc(PayloadName, Slot.Desc->ContainerTypes.GetFirstContainerType(), Slot.Desc->ValueType, Slot.Desc->ValueTypeObject) });
+
+		const FPropertyBagPropertyDesc* PayloadDesc = Payload->Value.FindPropertyDescByName(PayloadName);
+		if (!PayloadDesc || !PayloadDesc->CachedProperty || !PayloadDesc->CachedProperty->SameType(Slot.Property))
+		{
+			return nullptr;
+		}
+
+		Payload->Property = PayloadDesc->CachedProperty;
+		Payload->Memory = Payload->Value.GetMutableValue().GetMemory() + Payload->Property->GetOffset_ForInternal();
+		Payload->Property->CopyCompleteValue(Payload->Memory, Value);
+
+		// colliding payload stays with its contexts but is not found anymore
+		Payload->SourceProperty = Key.Key;
+		Payload->Hash = Key.Value;
+		++PayloadStructs.FindOrAdd(Payload->Value.GetPropertyBagStruct());
+		Entries.Add(Key, Payload);
+		return Payload;
+	}
+
+	void Remove(const FEnhancedAsyncSharedCapture& Payload)
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		const FKey Key(Payload.SourceProperty, Payload.Hash);
+		if (const TWeakPtr<FEnhancedAsyncSharedCapture>* Entry = Entries.Find(Key); Entry && !Entry->IsValid())
+		{
+			Entries.Remove(Key);
+		}
+
+		const UPropertyBag* Struct = Payload.Value.GetPropertyBagStruct();
+		if (int32* NumPayloads = PayloadStructs.Find(Struct); NumPayloads && --*NumPayloads == 0)
+		{
+			PayloadStructs.Remove(Struct);
+		}
+	}
+
+	int32 Num() const
+	{
+		FScopeLock Lock(&CriticalSection);
+		return Entries.Num();
+	}
+
+	virtual FString GetReferencerName() const override { return TEXT("FEnhancedAsyncSharedCaptureCache"); }
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+	{
+		FScopeLock Lock(&CriticalSection);
+		for (const TPair<const UPropertyBag*, int32>& Pair : PayloadStructs)
+		{
+			const UPropertyBag* Struct = Pair.Key;
+			Collector.AddReferencedObject(Struct);
+		}
+	}
+};
+
+FEnhancedAsyncSharedCapture::~FEnhancedAsyncSharedCapture()
+{
+	if (SourceProperty != nullptr)
+	{
+		FEnhancedAsyncSharedCaptureCache::Get().Remove(*this);
+	}
+}
+
+int32 FEnhancedAsyncActionContext_PropertyBagBase::GetNumSharedCapturePayloads()
+{
+	return FEnhancedAsyncSharedCaptureCache::Get().Num();
+}
+
+bool FEnhancedAsyncActionContext_PropertyBagBase::TryShareCapture(int32 Index, const FEnhancedAsyncContextLayout::FSlot& Slot, const void* Value)
+{
+	// cache is only touched by game thread
+	if (!bShareCapturesAllowed || !IsInGameThread() || !FEnhancedAsyncSharedCaptureCache::CanShare(Slot.Property)
+		|| !UEnhancedAsyncContextSettings::Get()->IsCaptureSharingEnabled())
+		return false;
+
+	TSharedPtr<FEnhancedAsyncSharedCapture> Payload = FEnhancedAsyncSharedCaptureCache::Get().FindOrAdd(Slot, Value);
+	if (!Payload.IsValid())
+		return false;
+
+	FSharedCapture* Shared = SharedCaptures.FindByPredicate([Index](const FSharedCapture& Other) { return Other.Index == Index; });
+	if (Shared == nullptr)
+	{
+		// value owned by slot is not read anymore
+		Slot.Property->ClearValue(GetSlotMemory(Slot));
+		Shared = &SharedCaptures.AddDefaulted_GetRef();
+		Shared->Index = Index;
+	}
+	Shared->Payload = MoveTemp(Payload);
+	return true;
+}
+
+const uint8* FEnhancedAsyncActionContext_PropertyBagBase::FindSharedValue(int32 Index) const
+{
+	for (const FSharedCapture& Shared : SharedCaptures)
+	{
+		if (Shared.Index == Index)
+		{
+			return Shared.Payload->Memory;
+		}
+	}
+	return nullptr;
+}
+
+void FEnhancedAsyncActionContext_PropertyBagBase::ReleaseSharedCapture(int32 Index)
+{
+	// other contexts keep reading the payload, this one gets its own copy
+	SharedCaptures.RemoveAllSwap([Index](const FSharedCapture& Shared) { return Shared.Index == Index; }, EAllowShrinking::No);
+}
+
+const uint8* FEnhancedAsyncActionContext_PropertyBagBase::GetSlotReadMemory(int32 Index, const FEnhancedAsyncContextLayout::FSlot& Slot) const
+{
+	const uint8* Shared = SharedCaptures.IsEmpty() ? nullptr : FindSharedValue(Index);
+	return Shared ? Shared : GetSlotMemory(Slot);
+}
+
+void FEnhancedAsyncActionContext_PropertyBagBase::BeginStaging()
+{
+	// locked layout has nothing to declare
+	bStaging = !bPropertyBagStructureLocked;
+}
+
+void FEnhancedAsyncActionContext_PropertyBagBase::CommitStaging()
+{
+	if (!bStaging)
+		return;
+
+	bStaging = false;
+
+	if (!StagedDescs.IsEmpty())
+	{
+		// value is migrated a single time for all new captures
+		GetValueRef()->AddProperties(StagedDescs);
+		RefreshLayout();
+	}
+
+	for (FStagedWrite& Staged : StagedWrites)
+	{
+		if (Staged.Property)
+		{
+			uint8* Memory = StagedBuffer.GetData() + Staged.Offset;
+			ensureAlways(SetValueByName(Staged.Name, Staged.Property, Memory) == EContextAccessResult::Success);
+			Staged.Property->DestroyValue(Memory);
+		}
+		else
+		{
+			Staged.Write();
+		}
+	}
+
+	StagedDescs.Reset();
+	StagedWrites.Reset();
+	StagedBuffer.Reset();
+}
+
+void FEnhancedAsyncActionContext_PropertyBagBase::ResetStaging()
+{
+	for (const FStagedWrite& Staged : StagedWrites)
+	{
+		if (Staged.Property)
+		{
+			Staged.Property->DestroyValue(StagedBuffer.GetData() + Staged.Offset);
+		}
+	}
+
+	bStaging = false;
+	StagedDescs.Reset();
+	StagedWrites.Reset();
+	StagedBuffer.Reset();
+}
+
+FEnhancedAsyncActionContext_PropertyBagBase::EStageResult FEnhancedAsyncActionContext_PropertyBagBase::StageDesc(const FPropertyBagPropertyDesc& Desc)
+{
+	if (bPropertyBagStructureLocked || GetValueRef()->FindPropertyDescByName(Desc.Name))
+		return EStageResult::WriteNow;
+
+	const FPropertyBagPropertyDesc* Staged = StagedDescs.FindByPredicate([&Desc](const FPropertyBagPropertyDesc& Other) { return Other.Name == Desc.Name; });
+	if (Staged == nullptr)
+	{
+		StagedDescs.Add(Desc);
+	}
+	else if (Staged->ValueType != Desc.ValueType || Staged->ValueTypeObject != Desc.ValueTypeObject
+		|| Staged->ContainerTypes.GetFirstContainerType() != Desc.ContainerTypes.GetFirstContainerType())
+	{
+		return EStageResult::Conflict;
+	}
+	return EStageResult::Staged;
+}
+
+bool FEnhancedAsyncActionContext_PropertyBagBase::StageWrite(const FPropertyBagPropertyDesc& Desc, TUniqueFunction<void()>&& Write)
+{
+	const EStageResult Result = StageDesc(Desc);
+	if (Result == EStageResult::WriteNow)
+		return false;
+
+	if (ensureAlwaysMsgf(Result == EStageResult::Staged, TEXT("Capture %s is already staged with another type"), *Desc.Name.ToString()))
+	{
+		FStagedWrite& Staged = StagedWrites.AddDefaulted_GetRef();
+		Staged.Name = Desc.Name;
+		Staged.Write = MoveTemp(Write);
+	}
+	return true;
+}
+
+FEnhancedAsyncActionContext_PropertyBagBase::EStageResult FEnhancedAsyncActionContext_PropertyBagBase::StagePropertyWrite(const FPropertyBagPropertyDesc& Desc, const FProperty* Property, const void* Value)
+{
+	if (Desc.ValueType == EPropertyBagPropertyType::None || Desc.ValueType == EPropertyBagPropertyType::Count)
+		return EStageResult::WriteNow;
+
+	const EStageResult Result = StageDesc(Desc);
+	if (Result != EStageResult::Staged)
+		return Result;
+
+	// value is copied with the property it came from, no bag is built until commit
+	check(Property->GetMinAlignment() <= StagedBufferAlignment);
+	const int32 Offset = Align(StagedBuffer.Num(), Property->GetMinAlignment());
+	StagedBuffer.SetNumUninitialized(Offset + Property->GetSize(), EAllowShrinking::No);
+
+	uint8* Memory = StagedBuffer.GetData() + Offset;
+	Property->InitializeValue(Memory);
+	Property->CopyCompleteValueFromScriptVM(Memory, Value);
+
+	FStagedWrite& Staged = StagedWrites.AddDefaulted_GetRef();
+	Staged.Name = Desc.Name;
+	Staged.Property = Property;
+	Staged.Offset = Offset;
+	return EStageResult::Staged;
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::DebugDump(FStringBuilderBase& Builder) const
@@ -139,6 +615,18 @@ void FEnhancedAsyncActionContext_PropertyBagBase::DebugDump(FStringBuilderBase&
 			Builder.Append(TEXT("\n"));
 		}
 	}
+
+	for (const FSharedCapture& Shared : SharedCaptures)
+	{
+		Builder.Appendf(TEXT("Capture %d shared payload=%p refs=%d\n"), Shared.Index, Shared.Payload->Memory, Shared.Payload.GetSharedReferenceCount());
+	}
+
+	for (const FMapCapture& Capture : MapCaptures)
+	{
+		FString ExportResult;
+		Capture.Property->ExportText_Direct(ExportResult, Capture.Memory, Capture.Memory, nullptr, PPF_Copy|PPF_DebugDump|PPF_Delimited);
+		Builder.Appendf(TEXT("Capture %d map [%s] Value=[%s]\n"), Capture.Index, *Capture.Property->GetCPPType(nullptr, CPPF_None), *ExportResult);
+	}
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetupFromProperties(TConstArrayView<TPair<FName, const FProperty*>> Properties)
@@ -148,7 +636,12 @@ void FEnhancedAsyncActionContext_PropertyBagBase::SetupFromProperties(TConstArra
 
 	UE_LOG(LogEnhancedAction, Log, TEXT("SetupFromProperties %d"), Properties.Num());
 
+	// pooled layouts are only shared by contexts that had no properties before setup
+	const bool bUsePool = CanRecycle() && !GetValueRef()->IsValid();
+
 	TArray<FPropertyBagPropertyDesc> Registrations;
+	TStringBuilder<256> LayoutKey;
+	LayoutKey.AppendChar(TEXT('@'));
 
 	for (const TPair<FName, const FProperty*>& Tuple : Properties)
 	{
@@ -161,10 +654,29 @@ void FEnhancedAsyncActionContext_PropertyBagBase::SetupFromProperties(TConstArra
 		// @note: DO NOT USE FPropertyBagPropertyDesc FProperty constructor
 		// Engine GetValueTypeObjectFromProperty is buggy in 5.5 and earlier
 		// there is no need in metadata carry over so can ignore that
-		Registrations.Add(FPropertyBagPropertyDesc(Tuple.Key, ContainerType, ValueType, ValueTypeObject));
+		const FPropertyBagPropertyDesc& Desc = Registrations.Add_GetRef(FPropertyBagPropertyDesc(Tuple.Key, ContainerType, ValueType, ValueTypeObject));
+
+		if (bUsePool)
+		{
+			AppendPropertyLayoutKey(LayoutKey, Desc);
+		}
+	}
+
+	if (bUsePool && InitializeFromPooledLayout(LayoutKey.ToString()))
+	{
+		RefreshLayout();
+		bPropertyBagStructureLocked = true;
+		bSetupContextAllowed = false;
+		return;
 	}
 
 	GetValueRef()->AddProperties(Registrations);
+	RefreshLayout();
+
+	if (bUsePool)
+	{
+		RegisterPooledLayout(LayoutKey.ToString());
+	}
 
 	bPropertyBagStructureLocked = true;
 	bSetupContextAllowed = false;
@@ -177,35 +689,104 @@ void FEnhancedAsyncActionContext_PropertyBagBase::SetupFromStringDefinition(cons
 
 	UE_LOG(LogEnhancedAction, Log, TEXT("SetupFromStringData %s"), *InDefinition);
 
+	// cached and pooled layouts are only shared by contexts that had no properties before setup
+	const bool bEmptyValue = !GetValueRef()->IsValid();
+	const bool bUsePool = CanRecycle() && bEmptyValue;
+	if (bUsePool && InitializeFromPooledLayout(InDefinition))
+	{
+		RefreshLayout();
+		bPropertyBagStructureLocked = true;
+		bSetupContextAllowed = false;
+		return;
+	}
+
+	// partial layouts missing types that are not loaded yet must not be pooled under the full definition
+	bool bComplete = false;
+	if (bEmptyValue)
+	{
+		if (const UPropertyBag* BagStruct = FEnhancedAsyncContextLayout::FindOrAddDefinition(InDefinition, bComplete))
+		{
+			GetValueRef()->InitializeFromBagStruct(BagStruct);
+		}
+		else
+		{
+			bComplete = false;
+		}
+	}
+	else
+	{
+		TArray<FPropertyBagPropertyDesc> Registrations;
+		ParseStringDefinition(InDefinition, Registrations);
+
+		// all properties are added at once so bag struct is resolved a single time
+		GetValueRef()->AddProperties(Registrations);
+	}
+	RefreshLayout();
+
+	if (bUsePool && bComplete)
+	{
+		RegisterPooledLayout(InDefinition);
+	}
+
+	bPropertyBagStructureLocked = true;
+	bSetupContextAllowed = false;
+}
+
+static bool RequiresValueTypeObject(EPropertyBagPropertyType ValueType)
+{
+	switch (ValueType)
+	{
+	case EPropertyBagPropertyType::Enum:
+	case EPropertyBagPropertyType::Struct:
+	case EPropertyBagPropertyType::Object:
+	case EPropertyBagPropertyType::SoftObject:
+	case EPropertyBagPropertyType::Class:
+	case EPropertyBagPropertyType::SoftClass:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool FEnhancedAsyncActionContext_PropertyBagBase::ParseStringDefinition(const FString& InDefinition, TArray<FPropertyBagPropertyDesc>& OutDescs)
+{
 	TArray<FString> Splits;
 	InDefinition.ParseIntoArray(Splits, TEXT(";"));
 
+	bool bComplete = true;
 	for (int32 PropIndex = 0, Max = Splits.Num(); PropIndex < Max; ++PropIndex)
 	{
-		const FName PropertyName = EAA::Internals::IndexToName(PropIndex);
-
 		FPropertyTypeInfo TypeInfo;
-		ensure(FPropertyTypeInfo::ParseTypeInfo(Splits[PropIndex], TypeInfo));
-		if (TypeInfo.IsWildcard() || !TypeInfo.IsValid())
+		const bool bParsed = FPropertyTypeInfo::ParseTypeInfo(Splits[PropIndex], TypeInfo);
+		ensure(bParsed);
+		if (TypeInfo.IsWildcard() || TypeInfo.IsMap())
+			continue; // map captures are not declared in bag
+		if (!bParsed || !TypeInfo.IsValid() || (RequiresValueTypeObject(TypeInfo.ValueType) && !TypeInfo.ValueTypeObject))
+		{ // type object is resolved only if already loaded
+			bComplete = false;
 			continue;
+		}
 
 		switch (TypeInfo.ContainerType)
 		{
 		case EPropertyBagContainerType::None:
-			GetValueRef()->AddProperty(PropertyName, TypeInfo.ValueType, TypeInfo.ValueTypeObject);
-			break;
 		case EPropertyBagContainerType::Array:
 		case EPropertyBagContainerType::Set:
-			GetValueRef()->AddContainerProperty(PropertyName, TypeInfo.ContainerType, TypeInfo.ValueType, TypeInfo.ValueTypeObject);
+			OutDescs.Add(FPropertyBagPropertyDesc(EAA::Internals::IndexToName(PropIndex), TypeInfo.ContainerType, TypeInfo.ValueType, TypeInfo.ValueTypeObject));
 			break;
 		default:
 			checkNoEntry();
 			break;
 		}
 	}
+	return bComplete;
+}
 
-	bPropertyBagStructureLocked = true;
-	bSetupContextAllowed = false;
+void FEnhancedAsyncActionContext_PropertyBagBase::AppendPropertyLayoutKey(FStringBuilderBase& Key, const FPropertyBagPropertyDesc& Desc)
+{
+	// type objects are kept alive by pooled layout, so address is a stable part of the key
+	Desc.Name.AppendString(Key);
+	Key.Appendf(TEXT(":%d:%d:%p;"), (int32)Desc.ContainerTypes.GetFirstContainerType(), (int32)Desc.ValueType, Desc.ValueTypeObject.Get());
 }
 
 bool FEnhancedAsyncActionContext_PropertyBagBase::CanAddNewProperty(const FName& Name, EPropertyBagPropertyType Type) const
@@ -222,6 +803,8 @@ void FEnhancedAsyncActionContextStub::HandleStubCall()
 
 FEnhancedAsyncActionContext_PropertyBagBase::~FEnhancedAsyncActionContext_PropertyBagBase()
 {
+	ResetStaging();
+	ResetMapCaptures();
 	if (GetValueRef())
 	{
 		// GetValueRef()->DebugPurgeBag();
@@ -235,150 +818,307 @@ bool FEnhancedAsyncActionContext_PropertyBagBase::IsValid() const
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueBool(int32 Index, const bool& InValue)
 {
+	if (bool* Slot = FindSlotValue<bool>(Index, EPropertyBagPropertyType::Bool))
+	{
+		*Slot = InValue;
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
+	if (bStaging && StageWrite(FPropertyBagPropertyDesc(Name, EPropertyBagPropertyType::Bool), [this, Index, InValue]() { SetValueBool(Index, InValue); }))
+		return;
+
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::Bool))
 	{
 		GetValueRef()->AddProperty(Name, EPropertyBagPropertyType::Bool);
+		RefreshLayout();
 	}
 	VALIDATE_RESULT(GetValueRef()->SetValueBool(Name, InValue));
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueByte(int32 Index, const uint8& InValue)
 {
+	if (uint8* Slot = FindSlotValue<uint8>(Index, EPropertyBagPropertyType::Byte))
+	{
+		*Slot = InValue;
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
+	if (bStaging && StageWrite(FPropertyBagPropertyDesc(Name, EPropertyBagPropertyType::Byte), [this, Index, InValue]() { SetValueByte(Index, InValue); }))
+		return;
+
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::Byte))
 	{
 		GetValueRef()->AddProperty(Name, EPropertyBagPropertyType::Byte);
+		RefreshLayout();
 	}
 	VALIDATE_RESULT(GetValueRef()->SetValueByte(Name, InValue));
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueInt32(int32 Index, const int32& InValue)
 {
+	if (int32* Slot = FindSlotValue<int32>(Index, EPropertyBagPropertyType::Int32))
+	{
+		*Slot = InValue;
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
+	if (bStaging && StageWrite(FPropertyBagPropertyDesc(Name, EPropertyBagPropertyType::Int32), [this, Index, InValue]() { SetValueInt32(Index, InValue); }))
+		return;
+
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::Int32))
 	{
 		GetValueRef()->AddProperty(Name, EPropertyBagPropertyType::Int32);
+		RefreshLayout();
 	}
 	VALIDATE_RESULT(GetValueRef()->SetValueInt32(Name, InValue));
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueInt64(int32 Index, const int64& InValue)
 {
+	if (int64* Slot = FindSlotValue<int64>(Index, EPropertyBagPropertyType::Int64))
+	{
+		*Slot = InValue;
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
+	if (bStaging && StageWrite(FPropertyBagPropertyDesc(Name, EPropertyBagPropertyType::Int64), [this, Index, InValue]() { SetValueInt64(Index, InValue); }))
+		return;
+
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::Int64))
 	{
 		GetValueRef()->AddProperty(Name, EPropertyBagPropertyType::Int64);
+		RefreshLayout();
 	}
 	VALIDATE_RESULT(GetValueRef()->SetValueInt64(Name, InValue));
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueFloat(int32 Index, const float& InValue)
 {
+	if (float* Slot = FindSlotValue<float>(Index, EPropertyBagPropertyType::Float))
+	{
+		*Slot = InValue;
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
+	if (bStaging && StageWrite(FPropertyBagPropertyDesc(Name, EPropertyBagPropertyType::Float), [this, Index, InValue]() { SetValueFloat(Index, InValue); }))
+		return;
+
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::Float))
 	{
 		GetValueRef()->AddProperty(Name, EPropertyBagPropertyType::Float);
+		RefreshLayout();
 	}
 	VALIDATE_RESULT(GetValueRef()->SetValueFloat(Name, InValue));
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueDouble(int32 Index, const double& InValue)
 {
+	if (double* Slot = FindSlotValue<double>(Index, EPropertyBagPropertyType::Double))
+	{
+		*Slot = InValue;
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
+	if (bStaging && StageWrite(FPropertyBagPropertyDesc(Name, EPropertyBagPropertyType::Double), [this, Index, InValue]() { SetValueDouble(Index, InValue); }))
+		return;
+
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::Double))
 	{
 		GetValueRef()->AddProperty(Name, EPropertyBagPropertyType::Double);
+		RefreshLayout();
 	}
 	VALIDATE_RESULT(GetValueRef()->SetValueDouble(Name, InValue));
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueString(int32 Index, const FString& InValue)
 {
+	if (FString* Slot = FindSlotValue<FString>(Index, EPropertyBagPropertyType::String))
+	{
+		*Slot = InValue;
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
+	if (bStaging && StageWrite(FPropertyBagPropertyDesc(Name, EPropertyBagPropertyType::String), [this, Index, InValue]() { SetValueString(Index, InValue); }))
+		return;
+
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::String))
 	{
 		GetValueRef()->AddProperty(Name, EPropertyBagPropertyType::String);
+		RefreshLayout();
 	}
 	VALIDATE_RESULT(GetValueRef()->SetValueString(Name, InValue));
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueName(int32 Index, const FName& InValue)
 {
+	if (FName* Slot = FindSlotValue<FName>(Index, EPropertyBagPropertyType::Name))
+	{
+		*Slot = InValue;
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
+	if (bStaging && StageWrite(FPropertyBagPropertyDesc(Name, EPropertyBagPropertyType::Name), [this, Index, InValue]() { SetValueName(Index, InValue); }))
+		return;
+
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::Name))
 	{
 		GetValueRef()->AddProperty(Name, EPropertyBagPropertyType::Name);
+		RefreshLayout();
 	}
 	VALIDATE_RESULT(GetValueRef()->SetValueName(Name, InValue));
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueText(int32 Index, const FText& InValue)
 {
+	if (FText* Slot = FindSlotValue<FText>(Index, EPropertyBagPropertyType::Text))
+	{
+		*Slot = InValue;
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
+	if (bStaging && StageWrite(FPropertyBagPropertyDesc(Name, EPropertyBagPropertyType::Text), [this, Index, InValue]() { SetValueText(Index, InValue); }))
+		return;
+
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::Text))
 	{
 		GetValueRef()->AddProperty(Name, EPropertyBagPropertyType::Text);
+		RefreshLayout();
 	}
 	VALIDATE_RESULT(GetValueRef()->SetValueText(Name, InValue));
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueEnum(int32 Index, UEnum* ExpectedType, uint8 InValue)
 {
+	// bag enums are backed by uint8
+	if (uint8* Slot = FindSlotValue<uint8>(Index, EPropertyBagPropertyType::Enum, ExpectedType))
+	{
+		*Slot = InValue;
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
+	if (bStaging && StageWrite(FPropertyBagPropertyDesc(Name, EPropertyBagPropertyType::Enum, ExpectedType), [this, Index, ExpectedType, InValue]() { SetValueEnum(Index, ExpectedType, InValue); }))
+		return;
+
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::Enum))
 	{
 		GetValueRef()->AddProperty(Name, EPropertyBagPropertyType::Enum, ExpectedType);
+		RefreshLayout();
 	}
 	VALIDATE_RESULT(GetValueRef()->SetValueEnum(Name, InValue, ExpectedType));
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueStruct(int32 Index, UScriptStruct* ExpectedType, const uint8* InValue)
 {
+	const FEnhancedAsyncContextLayout::FSlot* Slot = FindLayoutSlot(Index);
+	if (Slot && Slot->Matches(EPropertyBagPropertyType::Struct, ExpectedType))
+	{
+		if (!TryShareCapture(Index, *Slot, InValue))
+		{
+			ReleaseSharedCapture(Index);
+			ExpectedType->CopyScriptStruct(GetSlotMemory(*Slot), InValue);
+		}
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
+	if (bStaging && StageWrite(FPropertyBagPropertyDesc(Name, EPropertyBagPropertyType::Struct, ExpectedType),
+		[this, Index, ExpectedType, Value = FInstancedStruct(FConstStructView(ExpectedType, InValue))]() { SetValueStruct(Index, ExpectedType, Value.GetMemory()); }))
+		return;
+
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::Struct))
 	{
 		GetValueRef()->AddProperty(Name, EPropertyBagPropertyType::Struct, ExpectedType);
+		RefreshLayout();
 	}
 	VALIDATE_RESULT(GetValueRef()->SetValueStruct(Name, FConstStructView(ExpectedType, InValue)));
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueObject(int32 Index, UClass* ExpectedClass, UObject* const& InValue)
 {
+	if (TObjectPtr<UObject>* Slot = FindSlotValue<TObjectPtr<UObject>>(Index, EPropertyBagPropertyType::Object, ExpectedClass))
+	{
+		*Slot = InValue;
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
+	if (bStaging && StageWrite(FPropertyBagPropertyDesc(Name, EPropertyBagPropertyType::Object, ExpectedClass), [this, Index, ExpectedClass, InValue]() { SetValueObject(Index, ExpectedClass, InValue); }))
+		return;
+
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::Object))
 	{
 		GetValueRef()->AddProperty(Name, EPropertyBagPropertyType::Object, ExpectedClass);
+		RefreshLayout();
 	}
 	VALIDATE_RESULT(GetValueRef()->SetValueObject(Name, InValue));
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueSoftObject(int32 Index, UClass* ExpectedClass, TSoftObjectPtr<UObject> const& InValue)
 {
+	if (FSoftObjectPtr* Slot = FindSlotValue<FSoftObjectPtr>(Index, EPropertyBagPropertyType::SoftObject, ExpectedClass))
+	{
+		*Slot = FSoftObjectPtr(InValue.ToSoftObjectPath());
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
+	if (bStaging && StageWrite(FPropertyBagPropertyDesc(Name, EPropertyBagPropertyType::SoftObject, ExpectedClass), [this, Index, ExpectedClass, InValue]() { SetValueSoftObject(Index, ExpectedClass, InValue); }))
+		return;
+
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::SoftObject))
 	{
 		GetValueRef()->AddProperty(Name, EPropertyBagPropertyType::SoftObject, ExpectedClass);
+		RefreshLayout();
 	}
 	VALIDATE_RESULT(GetValueRef()->SetValueSoftPath(Name, InValue.ToSoftObjectPath()));
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueClass(int32 Index, UClass* ExpectedMetaClass, UClass* const& InValue)
 {
+	if (TObjectPtr<UClass>* Slot = FindSlotValue<TObjectPtr<UClass>>(Index, EPropertyBagPropertyType::Class, ExpectedMetaClass))
+	{
+		*Slot = InValue;
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
+	if (bStaging && StageWrite(FPropertyBagPropertyDesc(Name, EPropertyBagPropertyType::Class, ExpectedMetaClass), [this, Index, ExpectedMetaClass, InValue]() { SetValueClass(Index, ExpectedMetaClass, InValue); }))
+		return;
+
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::Class))
 	{
 		GetValueRef()->AddProperty(Name, EPropertyBagPropertyType::Class, ExpectedMetaClass);
+		RefreshLayout();
 	}
 	VALIDATE_RESULT(GetValueRef()->SetValueClass(Name, InValue));
 }
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueSoftClass(int32 Index, UClass* ExpectedMetaClass, TSoftClassPtr<UObject> const& InValue)
 {
+	if (FSoftObjectPtr* Slot = FindSlotValue<FSoftObjectPtr>(Index, EPropertyBagPropertyType::SoftClass, ExpectedMetaClass))
+	{
+		*Slot = FSoftObjectPtr(InValue.ToSoftObjectPath());
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
+	if (bStaging && StageWrite(FPropertyBagPropertyDesc(Name, EPropertyBagPropertyType::SoftClass, ExpectedMetaClass), [this, Index, ExpectedMetaClass, InValue]() { SetValueSoftClass(Index, ExpectedMetaClass, InValue); }))
+		return;
+
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::SoftClass))
 	{
 		GetValueRef()->AddProperty(Name, EPropertyBagPropertyType::SoftClass, ExpectedMetaClass);
+		RefreshLayout();
 	}
 	VALIDATE_RESULT(GetValueRef()->SetValueSoftPath(Name, InValue.ToSoftObjectPath()));
 }
@@ -389,6 +1129,12 @@ void FEnhancedAsyncActionContext_PropertyBagBase::SetValueSoftClass(int32 Index,
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueBool(int32 Index, bool& OutValue)
 {
+	if (const bool* Slot = FindSlotValue<bool>(Index, EPropertyBagPropertyType::Bool))
+	{
+		OutValue = *Slot;
+		return;
+	}
+
 	auto Value = VALIDATE_RESULT(GetValueRef()->GetValueBool(EAA::Internals::IndexToName(Index)));
 	if (Value.HasValue())
 	{
@@ -398,6 +1144,12 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueBool(int32 Index, bool
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueByte(int32 Index, uint8& OutValue)
 {
+	if (const uint8* Slot = FindSlotValue<uint8>(Index, EPropertyBagPropertyType::Byte))
+	{
+		OutValue = *Slot;
+		return;
+	}
+
 	auto Value = VALIDATE_RESULT(GetValueRef()->GetValueByte(EAA::Internals::IndexToName(Index)));
 	if (Value.HasValue())
 	{
@@ -407,6 +1159,12 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueByte(int32 Index, uint
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueInt32(int32 Index, int32& OutValue)
 {
+	if (const int32* Slot = FindSlotValue<int32>(Index, EPropertyBagPropertyType::Int32))
+	{
+		OutValue = *Slot;
+		return;
+	}
+
 	auto Value = VALIDATE_RESULT(GetValueRef()->GetValueInt32(EAA::Internals::IndexToName(Index)));
 	if (Value.HasValue())
 	{
@@ -416,6 +1174,12 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueInt32(int32 Index, int
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueInt64(int32 Index, int64& OutValue)
 {
+	if (const int64* Slot = FindSlotValue<int64>(Index, EPropertyBagPropertyType::Int64))
+	{
+		OutValue = *Slot;
+		return;
+	}
+
 	auto Value = VALIDATE_RESULT(GetValueRef()->GetValueInt64(EAA::Internals::IndexToName(Index)));
 	if (Value.HasValue())
 	{
@@ -425,6 +1189,12 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueInt64(int32 Index, int
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueFloat(int32 Index, float& OutValue)
 {
+	if (const float* Slot = FindSlotValue<float>(Index, EPropertyBagPropertyType::Float))
+	{
+		OutValue = *Slot;
+		return;
+	}
+
 	auto Value = VALIDATE_RESULT(GetValueRef()->GetValueFloat(EAA::Internals::IndexToName(Index)));
 	if (Value.HasValue())
 	{
@@ -434,6 +1204,12 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueFloat(int32 Index, flo
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueDouble(int32 Index, double& OutValue)
 {
+	if (const double* Slot = FindSlotValue<double>(Index, EPropertyBagPropertyType::Double))
+	{
+		OutValue = *Slot;
+		return;
+	}
+
 	auto Value = VALIDATE_RESULT(GetValueRef()->GetValueDouble(EAA::Internals::IndexToName(Index)));
 	if (Value.HasValue())
 	{
@@ -443,6 +1219,12 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueDouble(int32 Index, do
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueName(int32 Index, FName& OutValue)
 {
+	if (const FName* Slot = FindSlotValue<FName>(Index, EPropertyBagPropertyType::Name))
+	{
+		OutValue = *Slot;
+		return;
+	}
+
 	auto Value = VALIDATE_RESULT(GetValueRef()->GetValueName(EAA::Internals::IndexToName(Index)));
 	if (Value.HasValue())
 	{
@@ -452,6 +1234,12 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueName(int32 Index, FNam
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueString(int32 Index, FString& OutValue)
 {
+	if (const FString* Slot = FindSlotValue<FString>(Index, EPropertyBagPropertyType::String))
+	{
+		OutValue = *Slot;
+		return;
+	}
+
 	auto Value = VALIDATE_RESULT(GetValueRef()->GetValueString(EAA::Internals::IndexToName(Index)));
 	if (Value.HasValue())
 	{
@@ -461,6 +1249,12 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueString(int32 Index, FS
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueText(int32 Index, FText& OutValue)
 {
+	if (const FText* Slot = FindSlotValue<FText>(Index, EPropertyBagPropertyType::Text))
+	{
+		OutValue = *Slot;
+		return;
+	}
+
 	auto Value = VALIDATE_RESULT(GetValueRef()->GetValueText(EAA::Internals::IndexToName(Index)));
 	if (Value.HasValue())
 	{
@@ -470,6 +1264,12 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueText(int32 Index, FTex
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueEnum(int32 Index, UEnum* ExpectedType, uint8& OutValue)
 {
+	if (const uint8* Slot = FindSlotValue<uint8>(Index, EPropertyBagPropertyType::Enum, ExpectedType))
+	{
+		OutValue = *Slot;
+		return;
+	}
+
 	OutValue = 0;
 
 	auto Value = VALIDATE_RESULT(GetValueRef()->GetValueEnum(EAA::Internals::IndexToName(Index), ExpectedType));
@@ -477,10 +1277,17 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueEnum(int32 Index, UEnu
 	{
 		OutValue = Value.GetValue();
 	}
-}
+}
+
+void FEnhancedAsyncActionContext_PropertyBagBase::GetValueStruct(int32 Index, UScriptStruct* ExpectedType, const uint8*& OutValue)
+{
+	const FEnhancedAsyncContextLayout::FSlot* Slot = FindLayoutSlot(Index);
+	if (Slot && Slot->Matches(EPropertyBagPropertyType::Struct, ExpectedType))
+	{
+		OutValue = GetSlotReadMemory(Index, *Slot);
+		return;
+	}
 
-void FEnhancedAsyncActionContext_PropertyBagBase::GetValueStruct(int32 Index, UScriptStruct* ExpectedType, const uint8*& OutValue)
-{
 	OutValue = nullptr;
 
 	auto Value = VALIDATE_RESULT(GetValueRef()->GetValueStruct(EAA::Internals::IndexToName(Index), ExpectedType));
@@ -492,6 +1299,12 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueStruct(int32 Index, US
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueObject(int32 Index, UClass* ExpectedClass, UObject*& OutValue)
 {
+	if (const TObjectPtr<UObject>* Slot = FindSlotValue<TObjectPtr<UObject>>(Index, EPropertyBagPropertyType::Object, ExpectedClass))
+	{
+		OutValue = *Slot;
+		return;
+	}
+
 	OutValue = nullptr;
 
 	auto Value = VALIDATE_RESULT(GetValueRef()->GetValueObject(EAA::Internals::IndexToName(Index), ExpectedClass));
@@ -503,6 +1316,12 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueObject(int32 Index, UC
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueClass(int32 Index, UClass* ExpectedMetaClass, UClass*& OutValue)
 {
+	if (const TObjectPtr<UClass>* Slot = FindSlotValue<TObjectPtr<UClass>>(Index, EPropertyBagPropertyType::Class, ExpectedMetaClass))
+	{
+		OutValue = *Slot;
+		return;
+	}
+
 	OutValue = nullptr;
 
 	auto Value = VALIDATE_RESULT(GetValueRef()->GetValueClass(EAA::Internals::IndexToName(Index)));
@@ -514,6 +1333,12 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueClass(int32 Index, UCl
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueSoftObject(int32 Index, UClass* ExpectedClass, TSoftObjectPtr<UObject>& OutValue)
 {
+	if (const FSoftObjectPtr* Slot = FindSlotValue<FSoftObjectPtr>(Index, EPropertyBagPropertyType::SoftObject, ExpectedClass))
+	{
+		OutValue = TSoftObjectPtr<UObject>(Slot->ToSoftObjectPath());
+		return;
+	}
+
 	OutValue = nullptr;
 
 	auto Value = VALIDATE_RESULT(GetValueRef()->GetValueSoftPath(EAA::Internals::IndexToName(Index)));
@@ -525,6 +1350,12 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueSoftObject(int32 Index
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueSoftClass(int32 Index, UClass* ExpectedMetaClass, TSoftClassPtr<UObject>& OutValue)
 {
+	if (const FSoftObjectPtr* Slot = FindSlotValue<FSoftObjectPtr>(Index, EPropertyBagPropertyType::SoftClass, ExpectedMetaClass))
+	{
+		OutValue = TSoftClassPtr<UObject>(Slot->ToSoftObjectPath());
+		return;
+	}
+
 	OutValue = nullptr;
 
 	auto Value = VALIDATE_RESULT(GetValueRef()->GetValueSoftPath(EAA::Internals::IndexToName(Index)));
@@ -540,10 +1371,23 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueSoftClass(int32 Index,
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueArray(int32 Index, EPropertyBagPropertyType Type, const UObject* TypeObject, const void* Value)
 {
+	const FEnhancedAsyncContextLayout::FSlot* Slot = FindLayoutSlot(Index);
+	if (Slot && Slot->Matches(Type, TypeObject, EPropertyBagContainerType::Array))
+	{
+		if (!TryShareCapture(Index, *Slot, Value))
+		{
+			ReleaseSharedCapture(Index);
+			Slot->Property->CopyCompleteValueFromScriptVM(GetSlotMemory(*Slot), Value);
+		}
+		return;
+	}
+
+	// container has no property to stage its value with, it is declared right away
 	const FName Name = EAA::Internals::IndexToName(Index);
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::Struct))
 	{
 		GetValueRef()->AddContainerProperty(Name, EPropertyBagContainerType::Array, Type, TypeObject);
+		RefreshLayout();
 	}
 	TValueOrError<const FPropertyBagArrayRef, EPropertyBagResult> ArrayData = GetValueRef()->GetArrayRef(Name);
 	if (ensureAlways(ArrayData.IsValid()))
@@ -558,6 +1402,13 @@ void FEnhancedAsyncActionContext_PropertyBagBase::SetValueArray(int32 Index, EPr
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueArray(int32 Index, EPropertyBagPropertyType Type, const UObject* TypeObject, void* Value)
 {
+	const FEnhancedAsyncContextLayout::FSlot* Slot = FindLayoutSlot(Index);
+	if (Slot && Slot->Matches(Type, TypeObject, EPropertyBagContainerType::Array))
+	{
+		Slot->Property->CopyCompleteValueToScriptVM(Value, GetSlotReadMemory(Index, *Slot));
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
 	TValueOrError<const FPropertyBagArrayRef, EPropertyBagResult> ArrayData = GetValueRef()->GetArrayRef(Name);
 	if (ensureAlways(ArrayData.IsValid()))
@@ -572,10 +1423,19 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueArray(int32 Index, EPr
 
 void FEnhancedAsyncActionContext_PropertyBagBase::SetValueSet(int32 Index, EPropertyBagPropertyType Type, const UObject* TypeObject, const void* Value)
 {
+	const FEnhancedAsyncContextLayout::FSlot* Slot = FindLayoutSlot(Index);
+	if (Slot && Slot->Matches(Type, TypeObject, EPropertyBagContainerType::Set))
+	{
+		Slot->Property->CopyCompleteValueFromScriptVM(GetSlotMemory(*Slot), Value);
+		return;
+	}
+
+	// container has no property to stage its value with, it is declared right away
 	const FName Name = EAA::Internals::IndexToName(Index);
 	if (CanAddNewProperty(Name, EPropertyBagPropertyType::Struct))
 	{
 		GetValueRef()->AddContainerProperty(Name, EPropertyBagContainerType::Set, Type, TypeObject);
+		RefreshLayout();
 	}
 	TValueOrError<const FPropertyBagSetRef, EPropertyBagResult> SetData = GetValueRef()->GetSetRef(Name);
 	if (ensureAlways(SetData.IsValid()))
@@ -590,6 +1450,13 @@ void FEnhancedAsyncActionContext_PropertyBagBase::SetValueSet(int32 Index, EProp
 
 void FEnhancedAsyncActionContext_PropertyBagBase::GetValueSet(int32 Index, EPropertyBagPropertyType Type, const UObject* TypeObject, void* Value)
 {
+	const FEnhancedAsyncContextLayout::FSlot* Slot = FindLayoutSlot(Index);
+	if (Slot && Slot->Matches(Type, TypeObject, EPropertyBagContainerType::Set))
+	{
+		Slot->Property->CopyCompleteValueToScriptVM(Value, GetSlotMemory(*Slot));
+		return;
+	}
+
 	const FName Name = EAA::Internals::IndexToName(Index);
 	TValueOrError<const FPropertyBagSetRef, EPropertyBagResult> SetData = GetValueRef()->GetSetRef(Name);
 	if (ensureAlways(SetData.IsValid()))
@@ -607,15 +1474,126 @@ void FEnhancedAsyncActionContext_PropertyBagBase::GetValueSet(int32 Index, EProp
 // ============ GENERICS ==============
 // ======================================
 
-bool FEnhancedAsyncActionContext_PropertyBagBase::SetValueByName(FName Name, const FProperty* Property, const void* Value, FString& Message)
+EContextAccessResult FEnhancedAsyncActionContext_PropertyBagBase::SetMapCapture(int32 Index, const FMapProperty* Property, const void* Value)
+{
+	if (Index == INDEX_NONE || !Value)
+	{
+		return EContextAccessResult::BadProperty;
+	}
+	if (!EAA::Internals::CanCaptureMap(Property))
+	{
+		return EContextAccessResult::UnsupportedType;
+	}
+
+	FMapCapture* Capture = MapCaptures.FindByPredicate([Index](const FMapCapture& Item) { return Item.Index == Index; });
+	if (Capture && !Capture->Property->SameType(Property))
+	{
+		return EContextAccessResult::IncompatibleType;
+	}
+	if (!Capture)
+	{
+		Capture = &MapCaptures.AddDefaulted_GetRef();
+		Capture->Index = Index;
+		Capture->Property = Property;
+		Capture->PropertyOwner = Property->GetOwnerStruct();
+		Capture->Memory = FMemory::Malloc(Property->GetElementSize(), Property->GetMinAlignment());
+		Property->InitializeValue(Capture->Memory);
+		// owner of map type is reported regardless of map contents
+		MarkHasObjectReferences();
+	}
+
+	EAA::Internals::CopyMapValue(Property, Capture->Memory, Value);
+	return EContextAccessResult::Success;
+}
+
+EContextAccessResult FEnhancedAsyncActionContext_PropertyBagBase::GetMapCapture(int32 Index, const FMapProperty* Property, void* OutValue, bool bConsume)
+{
+	const FMapCapture* Capture = MapCaptures.FindByPredicate([Index](const FMapCapture& Item) { return Item.Index == Index; });
+	if (!Capture || !OutValue)
+	{
+		return EContextAccessResult::UnknownProperty;
+	}
+	if (!Capture->Property->SameType(Property))
+	{
+		return EContextAccessResult::IncompatibleType;
+	}
+
+	if (bConsume)
+	{
+		FMemory::Memswap(OutValue, Capture->Memory, Property->GetElementSize());
+	}
+	else
+	{
+		EAA::Internals::CopyMapValue(Property, OutValue, Capture->Memory);
+	}
+	return EContextAccessResult::Success;
+}
+
+void FEnhancedAsyncActionContext_PropertyBagBase::ResetMapCaptures()
+{
+	for (FMapCapture& Capture : MapCaptures)
+	{
+		Capture.Property->DestroyValue(Capture.Memory);
+		FMemory::Free(Capture.Memory);
+	}
+	MapCaptures.Reset();
+}
+
+EContextAccessResult FEnhancedAsyncActionContext_PropertyBagBase::SetValueByIndex(int32 Index, const FProperty* Property, const void* Value)
+{
+	if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		return SetMapCapture(Index, MapProperty, Value);
+	}
+
+	const FEnhancedAsyncContextLayout::FSlot* Slot = FindLayoutSlot(Index);
+	if (Slot && Property && Value && (Slot->Property == Property || Slot->Property->SameType(Property)))
+	{
+		if (!TryShareCapture(Index, *Slot, Value))
+		{
+			ReleaseSharedCapture(Index);
+			Property->CopyCompleteValueFromScriptVM(GetSlotMemory(*Slot), Value);
+		}
+		return EContextAccessResult::Success;
+	}
+	// unknown or converted property goes through full compatibility check
+	return Super::SetValueByIndex(Index, Property, Value);
+}
+
+EContextAccessResult FEnhancedAsyncActionContext_PropertyBagBase::SetValueByName(FName Name, const FProperty* Property, const void* Value)
 {
 	if (!Property || Name.IsNone() || !Value)
 	{
-		Message = TEXT("Bad property");
-		return false;
+		return EContextAccessResult::BadProperty;
+	}
+
+	if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		return SetMapCapture(EAA::Internals::FindCaptureIndex(Name), MapProperty, Value);
+	}
+
+	if (!SharedCaptures.IsEmpty())
+	{
+		ReleaseSharedCapture(EAA::Internals::FindCaptureIndex(Name));
 	}
 
 	const FPropertyBagPropertyDesc* ContextProperty = GetValueRef()->FindPropertyDescByName(Name);
+	if (!ContextProperty && bStaging)
+	{
+		const FPropertyBagPropertyDesc Desc(Name,
+			EAA::Internals::GetContainerTypeFromProperty(Property),
+			EAA::Internals::GetValueTypeFromProperty(Property),
+			EAA::Internals::GetValueTypeObjectFromProperty(Property));
+		switch (StagePropertyWrite(Desc, Property, Value))
+		{
+		case EStageResult::Staged:
+			return EContextAccessResult::Success;
+		case EStageResult::Conflict:
+			return EContextAccessResult::IncompatibleType;
+		default:
+			break;
+		}
+	}
 	if (!ContextProperty)
 	{
 		if (ensureAlways(!bPropertyBagStructureLocked))
@@ -623,57 +1601,96 @@ bool FEnhancedAsyncActionContext_PropertyBagBase::SetValueByName(FName Name, con
 			// structure is not locked - free to add new property
 			GetValueRef()->AddProperty(Name, Property);
 			ContextProperty = GetValueRef()->FindPropertyDescByName(Name);
+			RefreshLayout();
 		}
 	}
 	if (!ContextProperty || !ContextProperty->CachedProperty)
 	{
-		Message = TEXT("Unknown context property");
-		return false;
+		return EContextAccessResult::UnknownProperty;
 	}
 	if (!EAA::Internals::IsCompatibleWithProperty(EAA::Internals::EAccessorRole::SETTER, ContextProperty, Property))
 	{
-		Message = TEXT("Incompatible type");
-		return false;
+		return EContextAccessResult::IncompatibleType;
 	}
 	void* ContextValueAddress = GetValueRef()->GetMutableValueAddress(ContextProperty);
 	if (!ContextValueAddress)
 	{
-		Message = TEXT("Missing context property data");
-		return false;
+		return EContextAccessResult::MissingData;
 	}
 
 	Property->CopyCompleteValueFromScriptVM(ContextValueAddress, Value);
-	return true;
+	return EContextAccessResult::Success;
+}
+
+EContextAccessResult FEnhancedAsyncActionContext_PropertyBagBase::GetValueByIndex(int32 Index, const FProperty* Property, void* OutValue)
+{
+	if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		return GetMapCapture(Index, MapProperty, OutValue, false);
+	}
+
+	const FEnhancedAsyncContextLayout::FSlot* Slot = FindLayoutSlot(Index);
+	if (Slot && Property && OutValue && (Slot->Property == Property || Slot->Property->SameType(Property)))
+	{
+		Property->CopyCompleteValueToScriptVM(OutValue, GetSlotReadMemory(Index, *Slot));
+		return EContextAccessResult::Success;
+	}
+	return Super::GetValueByIndex(Index, Property, OutValue);
+}
+
+EContextAccessResult FEnhancedAsyncActionContext_PropertyBagBase::ConsumeValueByIndex(int32 Index, const FProperty* Property, void* OutValue)
+{
+	if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		return GetMapCapture(Index, MapProperty, OutValue, true);
+	}
+
+	const FEnhancedAsyncContextLayout::FSlot* Slot = FindLayoutSlot(Index);
+	if (Slot && Property && OutValue && (Slot->Property == Property || Slot->Property->SameType(Property)))
+	{
+		// heap storage of identical type is exchanged with output instead of copied, shared payloads are copied
+		if (!FindSharedValue(Index) && (CastField<FStrProperty>(Property) || CastField<FArrayProperty>(Property) || CastField<FSetProperty>(Property) || CastField<FMapProperty>(Property)))
+		{
+			FMemory::Memswap(OutValue, GetSlotMemory(*Slot), Property->GetElementSize());
+			return EContextAccessResult::Success;
+		}
+	}
+	return GetValueByIndex(Index, Property, OutValue);
 }
 
-bool FEnhancedAsyncActionContext_PropertyBagBase::GetValueByName(FName Name, const FProperty* Property, void* OutValue, FString& Message)
+EContextAccessResult FEnhancedAsyncActionContext_PropertyBagBase::GetValueByName(FName Name, const FProperty* Property, void* OutValue)
 {
 	if (!Property || Name.IsNone() || !OutValue)
 	{
-		Message = TEXT("Bad property");
-		return false;
+		return EContextAccessResult::BadProperty;
+	}
+
+	if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		return GetMapCapture(EAA::Internals::FindCaptureIndex(Name), MapProperty, OutValue, false);
 	}
 
 	const FPropertyBagPropertyDesc* ContextProperty = GetValueRef()->FindPropertyDescByName(Name);
 	if (!ContextProperty || !ContextProperty->CachedProperty)
 	{
-		Message = TEXT("Unknown context property");
-		return false;
+		return EContextAccessResult::UnknownProperty;
 	}
 	if (!EAA::Internals::IsCompatibleWithProperty(EAA::Internals::EAccessorRole::GETTER, ContextProperty, Property))
 	{
-		Message = TEXT("Incompatible type");
-		return false;
+		return EContextAccessResult::IncompatibleType;
 	}
-	const void* ContextValueAddress = GetValueRef()->GetValueAddress(ContextProperty);
+	const void* ContextValueAddress = SharedCaptures.IsEmpty() ? nullptr : FindSharedValue(EAA::Internals::FindCaptureIndex(Name));
 	if (!ContextValueAddress)
 	{
-		Message = TEXT("Missing context property data");
-		return false;
+		ContextValueAddress = GetValueRef()->GetValueAddress(ContextProperty);
+	}
+	if (!ContextValueAddress)
+	{
+		return EContextAccessResult::MissingData;
 	}
 
 	Property->CopyCompleteValueToScriptVM(OutValue, ContextValueAddress);
-	return true;
+	return EContextAccessResult::Success;
 }
 
 #undef RETURN_GENERIC_FAIL
@@ -695,6 +1712,8 @@ FEnhancedAsyncActionContext_PropertyBagRef::FEnhancedAsyncActionContext_Property
 	OwnerRef = OwningObject;
 	ValueRef = ContainerObject;
 	bAddReferencedObjectsAllowed = bExpose;
+	// container may be changed outside of this context, so it is always reported
+	bHasObjectReferences = bExpose;
 }
 
 bool FEnhancedAsyncActionContext_PropertyBagRef::IsValid() const
@@ -707,6 +1726,8 @@ FEnhancedAsyncActionContext_PropertyBag::FEnhancedAsyncActionContext_PropertyBag
 	OwnerRef = OwningObject;
 	ValueRef = &Value;
 	bAddReferencedObjectsAllowed = true;
+	bRecycleAllowed = true;
+	bShareCapturesAllowed = true;
 }
 
 bool FEnhancedAsyncActionContext_PropertyBag::IsValid() const
@@ -714,4 +1735,298 @@ bool FEnhancedAsyncActionContext_PropertyBag::IsValid() const
 	return OwnerRef.IsValid() && GetValueRef() != nullptr;
 }
 
+void FEnhancedAsyncActionContext_PropertyBag::Reinitialize(const UObject* OwningObject)
+{
+	check(!Value.IsValid());
+	OwnerRef = OwningObject;
+	bPropertyBagStructureLocked = false;
+	bSetupContextAllowed = true;
+	bHasObjectReferences = false;
+	ResetStaging();
+}
+
+FInstancedPropertyBag FEnhancedAsyncActionContext_PropertyBag::DetachValue()
+{
+	// staging aborted by script exception must not be replayed by the next owner
+	ResetStaging();
+	SharedCaptures.Reset();
+	ResetMapCaptures();
+	FInstancedPropertyBag Result = MoveTemp(Value);
+	Value.Reset();
+	OwnerRef.Reset();
+	Layout.Reset();
+	return Result;
+}
+
+bool FEnhancedAsyncActionContext_PropertyBag::InitializeFromPooledLayout(const FString& LayoutKey)
+{
+	if (!FEnhancedAsyncContextPool::IsEnabled())
+		return false;
+
+	FEnhancedAsyncContextPool& Pool = FEnhancedAsyncContextManager::Get().GetContextPool();
+	const UPropertyBag* Layout = Pool.FindLayout(LayoutKey);
+	if (Layout == nullptr)
+		return false;
+
+	Pool.AcquireValue(Layout, Value);
+	return true;
+}
+
+void FEnhancedAsyncActionContext_PropertyBag::RegisterPooledLayout(const FString& LayoutKey)
+{
+	if (FEnhancedAsyncContextPool::IsEnabled())
+	{
+		FEnhancedAsyncContextManager::Get().GetContextPool().RegisterLayout(LayoutKey, Value.GetPropertyBagStruct());
+	}
+}
+
+// ======================================
+// ============ INLINE ==============
+// ======================================
+
+static int32 GetInlineValueSize(EPropertyBagPropertyType ValueType)
+{
+	switch (ValueType)
+	{
+	case EPropertyBagPropertyType::Bool:
+		return sizeof(bool);
+	case EPropertyBagPropertyType::Byte:
+	case EPropertyBagPropertyType::Enum:
+		return sizeof(uint8);
+	case EPropertyBagPropertyType::Int32:
+		return sizeof(int32);
+	case EPropertyBagPropertyType::Int64:
+		return sizeof(int64);
+	case EPropertyBagPropertyType::Float:
+		return sizeof(float);
+	case EPropertyBagPropertyType::Double:
+		return sizeof(double);
+	case EPropertyBagPropertyType::Name:
+		return sizeof(FName);
+	default:
+		return 0;
+	}
+}
+
+bool FEnhancedAsyncActionContext_Inline::FLayout::Add(FName Name, EPropertyBagContainerType ContainerType, EPropertyBagPropertyType ValueType, const UObject* TypeObject)
+{
+	const int32 Index = EAA::Internals::FindCaptureIndex(Name);
+	const int32 ValueSize = GetInlineValueSize(ValueType);
+	if (Index == INDEX_NONE || Index >= MaxSlots || ContainerType != EPropertyBagContainerType::None || ValueSize == 0)
+		return false;
+
+	FSlot& Slot = Slots[Index];
+	if (Slot.Type != EPropertyBagPropertyType::None)
+		return false;
+
+	const int32 Alignment = ValueType == EPropertyBagPropertyType::Name ? alignof(FName) : ValueSize;
+	const int32 Offset = Align(Size, Alignment);
+	if (Offset + ValueSize > BufferSize)
+		return false;
+
+	Slot.Enum = ValueType == EPropertyBagPropertyType::Enum ? Cast<const UEnum>(TypeObject) : nullptr;
+	Slot.Type = ValueType;
+	Slot.Offset = static_cast<uint8>(Offset);
+	Slot.Size = static_cast<uint8>(ValueSize);
+	Size = Offset + ValueSize;
+	return true;
+}
+
+bool FEnhancedAsyncActionContext_Inline::FLayout::Build(TConstArrayView<FPropertyBagPropertyDesc> Descs)
+{
+	for (const FPropertyBagPropertyDesc& Desc : Descs)
+	{
+		if (!Add(Desc.Name, Desc.ContainerTypes.GetFirstContainerType(), Desc.ValueType, Desc.ValueTypeObject))
+			return false;
+	}
+	return Size > 0;
+}
+
+bool FEnhancedAsyncActionContext_Inline::FLayout::Build(TConstArrayView<TPair<FName, const FProperty*>> Properties)
+{
+	for (const TPair<FName, const FProperty*>& Tuple : Properties)
+	{
+		auto ContainerType = EAA::Internals::GetContainerTypeFromProperty(Tuple.Value);
+		auto ValueType = EAA::Internals::GetValueTypeFromProperty(Tuple.Value);
+		auto ValueTypeObject = EAA::Internals::GetValueTypeObjectFromProperty(Tuple.Value);
+
+		if (!Add(Tuple.Key, ContainerType, ValueType, ValueTypeObject))
+			return false;
+	}
+	return Size > 0;
+}
+
+FEnhancedAsyncActionContext_Inline::FEnhancedAsyncActionContext_Inline(const UObject* OwningObject, const FLayout& InLayout)
+	: OwnerRef(OwningObject), Layout(InLayout)
+{
+	// zeroed memory is a valid default for every plain data type, including names
+	FMemory::Memzero(Buffer, BufferSize);
+	bAddReferencedObjectsAllowed = false;
+	bSetupContextAllowed = false;
+}
+
+bool FEnhancedAsyncActionContext_Inline::IsEnabled()
+{
+	return UEnhancedAsyncContextSettings::Get()->IsInlineContextEnabled();
+}
+
+void FEnhancedAsyncActionContext_Inline::HandleUnsupportedCall()
+{
+	ensureAlwaysMsgf(false, TEXT("Inline context does not hold captures of this type"));
+}
+
+void FEnhancedAsyncActionContext_Inline::DebugDump(FStringBuilderBase& Builder) const
+{
+	{
+		FStringBuilderBase HexData;
+		EAA::Internals::BytesToHexImpl(TConstArrayView<uint8>(Buffer, Layout.Size), HexData);
+		Builder.Appendf(TEXT("DATA base=%p:\n"), Buffer).Append(HexData).Append(TEXT("\n"));
+	}
+
+	for (int32 Index = 0; Index < MaxSlots; ++Index)
+	{
+		const FSlot& Slot = Layout.Slots[Index];
+		if (Slot.Type != EPropertyBagPropertyType::None)
+		{
+			Builder.Append("Property ").Append(EAA::Internals::IndexToName(Index).ToString());
+			Builder.Append(" [").Append(UEnum::GetValueAsString(Slot.Type)).Append("]");
+			Builder.Appendf(TEXT(" Offset=%d"), Slot.Offset);
+			Builder.Append(TEXT("\n"));
+		}
+	}
+}
+
+template <typename T>
+T* FEnhancedAsyncActionContext_Inline::FindValue(int32 Index, EPropertyBagPropertyType Type, const UEnum* Enum) const
+{
+	if (static_cast<uint32>(Index) < static_cast<uint32>(MaxSlots))
+	{
+		const FSlot& Slot = Layout.Slots[Index];
+		if (Slot.Type == Type && Slot.Enum == Enum)
+		{
+			return reinterpret_cast<T*>(Buffer + Slot.Offset);
+		}
+	}
+	// miss on user input is not an error of the context, accessor leaves value untouched like property bag backends do
+	UE_LOG(LogEnhancedAction, Verbose, TEXT("Inline context has no capture %d of type %s"), Index, *UEnum::GetValueAsString(Type));
+	return nullptr;
+}
+
+#define INLINE_SIMPLE_ACCESSOR(Name, Type) \
+	void FEnhancedAsyncActionContext_Inline::SetValue ##Name(int32 Index, Type const& InValue) \
+	{ \
+		if (Type* Value = FindValue<Type>(Index, EPropertyBagPropertyType::Name)) \
+		{ \
+			*Value = InValue; \
+		} \
+	} \
+	void FEnhancedAsyncActionContext_Inline::GetValue ##Name(int32 Index, Type& OutValue) \
+	{ \
+		if (const Type* Value = FindValue<Type>(Index, EPropertyBagPropertyType::Name)) \
+		{ \
+			OutValue = *Value; \
+		} \
+	}
+
+INLINE_SIMPLE_ACCESSOR(Bool, bool)
+INLINE_SIMPLE_ACCESSOR(Byte, uint8)
+INLINE_SIMPLE_ACCESSOR(Int32, int32)
+INLINE_SIMPLE_ACCESSOR(Int64, int64)
+INLINE_SIMPLE_ACCESSOR(Float, float)
+INLINE_SIMPLE_ACCESSOR(Double, double)
+INLINE_SIMPLE_ACCESSOR(Name, FName)
+
+#undef INLINE_SIMPLE_ACCESSOR
+
+void FEnhancedAsyncActionContext_Inline::SetValueEnum(int32 Index, UEnum* ExpectedType, uint8 InValue)
+{
+	if (uint8* Value = FindValue<uint8>(Index, EPropertyBagPropertyType::Enum, ExpectedType))
+	{
+		*Value = InValue;
+	}
+}
+
+void FEnhancedAsyncActionContext_Inline::GetValueEnum(int32 Index, UEnum* ExpectedType, uint8& OutValue)
+{
+	OutValue = 0;
+
+	if (const uint8* Value = FindValue<uint8>(Index, EPropertyBagPropertyType::Enum, ExpectedType))
+	{
+		OutValue = *Value;
+	}
+}
+
+const FEnhancedAsyncActionContext_Inline::FSlot* FEnhancedAsyncActionContext_Inline::FindSlot(int32 Index, const FProperty* Property, EContextAccessResult& OutResult) const
+{
+	if (!Property)
+	{
+		OutResult = EContextAccessResult::BadProperty;
+		return nullptr;
+	}
+	if (static_cast<uint32>(Index) >= static_cast<uint32>(MaxSlots) || Layout.Slots[Index].Type == EPropertyBagPropertyType::None)
+	{
+		OutResult = EContextAccessResult::UnknownProperty;
+		return nullptr;
+	}
+
+	OutResult = EContextAccessResult::IncompatibleType;
+	const FSlot& Slot = Layout.Slots[Index];
+	if (Slot.Size != Property->GetElementSize()
+		|| Slot.Type != EAA::Internals::GetValueTypeFromProperty(Property)
+		|| EAA::Internals::GetContainerTypeFromProperty(Property) != EPropertyBagContainerType::None)
+	{
+		return nullptr;
+	}
+	if (Slot.Enum != nullptr && Slot.Enum != EAA::Internals::GetValueTypeObjectFromProperty(Property))
+	{
+		return nullptr;
+	}
+	OutResult = EContextAccessResult::Success;
+	return &Slot;
+}
+
+EContextAccessResult FEnhancedAsyncActionContext_Inline::SetValueByIndex(int32 Index, const FProperty* Property, const void* Value)
+{
+	EContextAccessResult Result;
+	const FSlot* Slot = FindSlot(Index, Property, Result);
+	if (!Slot)
+	{
+		return Result;
+	}
+	if (!Value)
+	{
+		return EContextAccessResult::BadProperty;
+	}
+
+	Property->CopyCompleteValueFromScriptVM(Buffer + Slot->Offset, Value);
+	return EContextAccessResult::Success;
+}
+
+EContextAccessResult FEnhancedAsyncActionContext_Inline::SetValueByName(FName Name, const FProperty* Property, const void* Value)
+{
+	return SetValueByIndex(EAA::Internals::FindCaptureIndex(Name), Property, Value);
+}
+
+EContextAccessResult FEnhancedAsyncActionContext_Inline::GetValueByIndex(int32 Index, const FProperty* Property, void* OutValue)
+{
+	EContextAccessResult Result;
+	const FSlot* Slot = FindSlot(Index, Property, Result);
+	if (!Slot)
+	{
+		return Result;
+	}
+	if (!OutValue)
+	{
+		return EContextAccessResult::BadProperty;
+	}
+
+	Property->CopyCompleteValueToScriptVM(OutValue, Buffer + Slot->Offset);
+	return EContextAccessResult::Success;
+}
+
+EContextAccessResult FEnhancedAsyncActionContext_Inline::GetValueByName(FName Name, const FProperty* Property, void* OutValue)
+{
+	return GetValueByIndex(EAA::Internals::FindCaptureIndex(Name), Property, OutValue);
+}
+
 #undef VALIDATE_RESULT
@@ -5,9 +5,12 @@
 #include "StructUtils/PropertyBag.h"
 #include "EnhancedAsyncContextShared.h"
 #include "EnhancedAsyncContext.h"
+#include "EnhancedAsyncContextLayout.h"
 
 #define UE_API ENHANCEDASYNCACTION_API
 
+struct FEnhancedAsyncSharedCapture;
+
 /**
  * This is a stub with no implementation
  */
@@ -38,8 +41,8 @@ public:
 	CONTEXT_DECLARE_CONTAINER_ACCESSOR(Set)
 #undef CONTEXT_PROPERTY_ACCESSOR_MODE
 
-	virtual bool SetValueByName(FName Name, const FProperty* Property, const void* Value, FString& Message) override { HandleStubCall();return true; }
-	virtual bool GetValueByName(FName Name, const FProperty* Property, void* OutValue, FString& Message) override { HandleStubCall();return true; }
+	virtual EContextAccessResult SetValueByName(FName Name, const FProperty* Property, const void* Value) override { HandleStubCall();return EContextAccessResult::Success; }
+	virtual EContextAccessResult GetValueByName(FName Name, const FProperty* Property, void* OutValue) override { HandleStubCall();return EContextAccessResult::Success; }
 };
 
 /**
@@ -63,6 +66,17 @@ public:
 	virtual void SetupFromStringDefinition(const FString& InDefinition) override;
 	bool CanAddNewProperty(const FName& Name, EPropertyBagPropertyType Type) const;
 
+	/**
+	 * Collect bag properties described by string definition, wildcard entries are skipped
+	 *
+	 * @return false if some entry could not be parsed or its type was not resolved
+	 */
+	static bool ParseStringDefinition(const FString& InDefinition, TArray<FPropertyBagPropertyDesc>& OutDescs);
+	/** Append pooled layout key entry of property set up from captured property */
+	static void AppendPropertyLayoutKey(FStringBuilderBase& Key, const FPropertyBagPropertyDesc& Desc);
+	/** Number of live capture payloads shared between contexts */
+	static int32 GetNumSharedCapturePayloads();
+
 #define CONTEXT_PROPERTY_ACCESSOR_MODE override
 	CONTEXT_DECLARE_SIMPLE_ACCESSOR(Bool, bool)
 	CONTEXT_DECLARE_SIMPLE_ACCESSOR(Byte, uint8)
@@ -81,13 +95,105 @@ public:
 	CONTEXT_DECLARE_CONTAINER_ACCESSOR(Set)
 #undef CONTEXT_PROPERTY_ACCESSOR_MODE
 
-	virtual bool SetValueByName(FName Name, const FProperty* Property, const void* Value, FString& Message) override;
-	virtual bool GetValueByName(FName Name, const FProperty* Property, void* OutValue, FString& Message) override;
+	virtual EContextAccessResult SetValueByIndex(int32 Index, const FProperty* Property, const void* Value) override;
+	virtual EContextAccessResult SetValueByName(FName Name, const FProperty* Property, const void* Value) override;
+	virtual EContextAccessResult GetValueByIndex(int32 Index, const FProperty* Property, void* OutValue) override;
+	virtual EContextAccessResult GetValueByName(FName Name, const FProperty* Property, void* OutValue) override;
+	virtual EContextAccessResult ConsumeValueByIndex(int32 Index, const FProperty* Property, void* OutValue) override;
+
+	virtual void BeginStaging() override;
+	virtual void CommitStaging() override;
 protected:
 	inline class FFrieldlyInstancedPropertyBag* GetValueRef() const;
 
+	// Layout slot of capture at index, null if layout does not describe current value
+	const FEnhancedAsyncContextLayout::FSlot* FindLayoutSlot(int32 Index) const;
+	// Value memory of capture slot
+	uint8* GetSlotMemory(const FEnhancedAsyncContextLayout::FSlot& Slot) const;
+	// Value memory of capture at index if its slot holds the exact type, null to fall back to lookup by name
+	template <typename T>
+	T* FindSlotValue(int32 Index, EPropertyBagPropertyType Type, const UObject* TypeObject = nullptr) const;
+
+	// Point capture at immutable payload shared with contexts that captured identical value, false if value has to be copied
+	bool TryShareCapture(int32 Index, const FEnhancedAsyncContextLayout::FSlot& Slot, const void* Value);
+	// Value memory of shared payload of capture at index, null if capture owns its value
+	const uint8* FindSharedValue(int32 Index) const;
+	// Drop shared payload of capture at index before its own value is written
+	void ReleaseSharedCapture(int32 Index);
+	// Value memory of capture slot to read from, shared payload takes precedence over slot memory
+	const uint8* GetSlotReadMemory(int32 Index, const FEnhancedAsyncContextLayout::FSlot& Slot) const;
+
+	// Property bag has no map container, map captures are kept aside of the value
+	EContextAccessResult SetMapCapture(int32 Index, const FMapProperty* Property, const void* Value);
+	EContextAccessResult GetMapCapture(int32 Index, const FMapProperty* Property, void* OutValue, bool bConsume);
+	void ResetMapCaptures();
+
+	enum class EStageResult : uint8
+	{
+		// capture is declared in value, write it now
+		WriteNow,
+		Staged,
+		// capture is already staged with another type
+		Conflict,
+	};
+	// Declare capture missing in value until staging is committed
+	EStageResult StageDesc(const FPropertyBagPropertyDesc& Desc);
+	// Defer write of capture missing in value until staging is committed, false if capture can be written now
+	bool StageWrite(const FPropertyBagPropertyDesc& Desc, TUniqueFunction<void()>&& Write);
+	// Defer write of reflected value, value is copied into staging buffer until commit
+	EStageResult StagePropertyWrite(const FPropertyBagPropertyDesc& Desc, const FProperty* Property, const void* Value);
+	// Drop uncommitted staging, writes may reference values of a previous owner
+	void ResetStaging();
+
+	// Initialize empty value from layout already resolved for the key, returns true if structure is set up
+	virtual bool InitializeFromPooledLayout(const FString& LayoutKey) { return false; }
+	// Share resolved layout with following setups using the same key
+	virtual void RegisterPooledLayout(const FString& LayoutKey) { }
+
+	// Update cached layout traits after value structure was changed
+	void RefreshLayout();
+
 	FInstancedPropertyBag* ValueRef = nullptr;
 	bool bPropertyBagStructureLocked = false;
+	// Traits of current value layout
+	TSharedPtr<const FEnhancedAsyncContextLayout> Layout;
+
+	// Declarations of new captures are collected until commit
+	bool bStaging = false;
+	TArray<FPropertyBagPropertyDesc> StagedDescs;
+
+	// Write deferred until commit, in order of calls
+	struct FStagedWrite
+	{
+		FName Name;
+		// Property of value copied into staging buffer, null if write is deferred as function
+		const FProperty* Property = nullptr;
+		int32 Offset = 0;
+		TUniqueFunction<void()> Write;
+	};
+	TArray<FStagedWrite> StagedWrites;
+	// Reflected values of staged writes laid out back to back, values are bitwise relocatable
+	static constexpr uint32 StagedBufferAlignment = 16;
+	TArray<uint8, TAlignedHeapAllocator<StagedBufferAlignment>> StagedBuffer;
+
+	// Large captures pointing at payload shared with other contexts, slot memory of them holds default value
+	struct FSharedCapture
+	{
+		int32 Index = INDEX_NONE;
+		TSharedPtr<FEnhancedAsyncSharedCapture> Payload;
+	};
+	bool bShareCapturesAllowed = false;
+	TArray<FSharedCapture, TInlineAllocator<2>> SharedCaptures;
+
+	struct FMapCapture
+	{
+		int32 Index = INDEX_NONE;
+		const FMapProperty* Property = nullptr;
+		// owner of reflected map type is kept alive while value is held
+		TObjectPtr<UStruct> PropertyOwner;
+		void* Memory = nullptr;
+	};
+	TArray<FMapCapture, TInlineAllocator<1>> MapCaptures;
 };
 
 /**
@@ -123,9 +229,103 @@ public:
 	virtual const UObject* GetOwningObject() const override { return OwnerRef.GetEvenIfUnreachable(); }
 	virtual FString GetDebugName() const override { return TEXT("FEnhancedAsyncActionContext_PropertyBag"); }
 	virtual bool IsValid() const override;
+
+	/** Prepare recycled context for a new owner, value must be detached beforehand */
+	void Reinitialize(const UObject* OwningObject);
+	/** Move value memory out of released context */
+	FInstancedPropertyBag DetachValue();
+	/** Value has no properties yet */
+	bool IsEmpty() const { return !Value.IsValid(); }
 protected:
+	virtual bool InitializeFromPooledLayout(const FString& LayoutKey) override;
+	virtual void RegisterPooledLayout(const FString& LayoutKey) override;
+
 	TWeakObjectPtr<const UObject> OwnerRef;
 	FInstancedPropertyBag Value;
 };
 
+/**
+ * Context container storing plain data captures in inline buffer.
+ *
+ * Selected on setup when all captures are bools, numbers, enums or names and fit the buffer,
+ * saves bag struct resolution, value allocation and reflected copies.
+ */
+class UE_API FEnhancedAsyncActionContext_Inline : public FEnhancedAsyncActionContext
+{
+	using Super = FEnhancedAsyncActionContext;
+public:
+	static constexpr int32 BufferSize = 128;
+	static constexpr int32 MaxSlots = EAA::Internals::MaxCapturePins;
+
+	struct FSlot
+	{
+		// Expected type of enum capture
+		const UEnum* Enum = nullptr;
+		// Type tag, None for unused slot
+		EPropertyBagPropertyType Type = EPropertyBagPropertyType::None;
+		uint8 Offset = 0;
+		uint8 Size = 0;
+	};
+
+	/** Placement of captures in buffer, indexed by capture index */
+	struct FLayout
+	{
+		TStaticArray<FSlot, MaxSlots> Slots;
+		int32 Size = 0;
+
+		/** Place capture, false if it is not plain data or does not fit */
+		bool Add(FName Name, EPropertyBagContainerType ContainerType, EPropertyBagPropertyType ValueType, const UObject* TypeObject);
+		bool Build(TConstArrayView<FPropertyBagPropertyDesc> Descs);
+		bool Build(TConstArrayView<TPair<FName, const FProperty*>> Properties);
+	};
+
+	FEnhancedAsyncActionContext_Inline(const UObject* OwningObject, const FLayout& InLayout);
+
+	static bool IsEnabled();
+
+	virtual const UObject* GetOwningObject() const override { return OwnerRef.GetEvenIfUnreachable(); }
+	virtual FString GetDebugName() const override { return TEXT("FEnhancedAsyncActionContext_Inline"); }
+	virtual bool IsValid() const override { return OwnerRef.IsValid(); }
+	virtual void DebugDump(FStringBuilderBase& Builder) const override;
+
+#define CONTEXT_PROPERTY_ACCESSOR_MODE override
+	CONTEXT_DECLARE_SIMPLE_ACCESSOR(Bool, bool)
+	CONTEXT_DECLARE_SIMPLE_ACCESSOR(Byte, uint8)
+	CONTEXT_DECLARE_SIMPLE_ACCESSOR(Int32, int32)
+	CONTEXT_DECLARE_SIMPLE_ACCESSOR(Int64, int64)
+	CONTEXT_DECLARE_SIMPLE_ACCESSOR(Float, float)
+	CONTEXT_DECLARE_SIMPLE_ACCESSOR(Double, double)
+	CONTEXT_DECLARE_SIMPLE_ACCESSOR(Name, FName)
+	CONTEXT_DECLARE_ENUM_ACCESSOR(Enum)
+#undef CONTEXT_PROPERTY_ACCESSOR_MODE
+
+	// captures that are not plain data are never placed in inline context
+#define CONTEXT_PROPERTY_ACCESSOR_MODE override { HandleUnsupportedCall(); }
+	CONTEXT_DECLARE_SIMPLE_ACCESSOR(String, FString)
+	CONTEXT_DECLARE_SIMPLE_ACCESSOR(Text, FText)
+	CONTEXT_DECLARE_STRUCT_ACCESSOR(Struct)
+	CONTEXT_DECLARE_OBJECT_ACCESSOR(Object)
+	CONTEXT_DECLARE_CLASS_ACCESSOR(Class)
+	CONTEXT_DECLARE_CONTAINER_ACCESSOR(Array)
+	CONTEXT_DECLARE_CONTAINER_ACCESSOR(Set)
+#undef CONTEXT_PROPERTY_ACCESSOR_MODE
+
+	virtual EContextAccessResult SetValueByIndex(int32 Index, const FProperty* Property, const void* Value) override;
+	virtual EContextAccessResult SetValueByName(FName Name, const FProperty* Property, const void* Value) override;
+	virtual EContextAccessResult GetValueByIndex(int32 Index, const FProperty* Property, void* OutValue) override;
+	virtual EContextAccessResult GetValueByName(FName Name, const FProperty* Property, void* OutValue) override;
+private:
+	static void HandleUnsupportedCall();
+
+	// Value memory of capture at index if its slot holds the type, null on miss
+	template <typename T>
+	T* FindValue(int32 Index, EPropertyBagPropertyType Type, const UEnum* Enum = nullptr) const;
+	// Slot of capture at index compatible with reflected property
+	const FSlot* FindSlot(int32 Index, const FProperty* Property, EContextAccessResult& OutResult) const;
+
+	TWeakObjectPtr<const UObject> OwnerRef;
+	FLayout Layout;
+	alignas(16) mutable uint8 Buffer[BufferSize];
+};
+
 #undef UE_API
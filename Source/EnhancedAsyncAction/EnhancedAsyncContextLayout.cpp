@@ -0,0 +1,180 @@
+﻿// Copyright 2025, Aquanox.
+
+#include "EnhancedAsyncContextLayout.h"
+
+#include "EnhancedAsyncContextImpl.h"
+#include "EnhancedAsyncContextShared.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/GCObject.h"
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectGlobals.h"
+
+/**
+ * Cache of layout traits keyed by bag struct, entries of collected structs are dropped after purge.
+ * Bag structs of layouts held by contexts are kept alive while held, contexts skipped by collection rely on it.
+ * Bag structs built from config strings are kept alive for the whole process.
+ */
+struct FEnhancedAsyncContextLayoutCache : public FGCObject
+{
+	FRWLock Lock;
+	TMap<const UPropertyBag*, TSharedPtr<const FEnhancedAsyncContextLayout>> Layouts;
+
+	FRWLock DefinitionLock;
+	TMap<FString, const UPropertyBag*> Definitions;
+
+	static FEnhancedAsyncContextLayoutCache& Get()
+	{
+		static FEnhancedAsyncContextLayoutCache Instance;
+		return Instance;
+	}
+
+	virtual FString GetReferencerName() const override { return TEXT("FEnhancedAsyncContextLayoutCache"); }
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+	{
+		{
+			FReadScopeLock ScopeLock(Lock);
+			for (const TPair<const UPropertyBag*, TSharedPtr<const FEnhancedAsyncContextLayout>>& Pair : Layouts)
+			{
+				// layout referenced only by the cache is not in use
+				if (Pair.Value.GetSharedReferenceCount() > 1)
+				{
+					const UPropertyBag* Struct = Pair.Key;
+					Collector.AddReferencedObject(Struct);
+				}
+			}
+		}
+
+		FReadScopeLock ScopeLock(DefinitionLock);
+		for (TPair<FString, const UPropertyBag*>& Pair : Definitions)
+		{
+			Collector.AddReferencedObject(Pair.Value);
+		}
+	}
+private:
+	FEnhancedAsyncContextLayoutCache()
+	{
+		FCoreUObjectDelegates::GetPostPurgeGarbageDelegate().AddRaw(this, &FEnhancedAsyncContextLayoutCache::PurgeStale);
+	}
+
+	void PurgeStale()
+	{
+		FWriteScopeLock ScopeLock(Lock);
+		for (auto It = Layouts.CreateIterator(); It; ++It)
+		{
+			if (It.Value()->GetStruct() == nullptr)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+};
+
+FEnhancedAsyncContextLayout::FEnhancedAsyncContextLayout(const UPropertyBag* InStruct)
+	: Struct(InStruct)
+{
+	for (TFieldIterator<FProperty> It(InStruct); It; ++It)
+	{
+		const FProperty* Property = *It;
+
+		TArray<const FStructProperty*> EncounteredStructProps;
+		if (!Property->ContainsObjectReference(EncounteredStructProps, EPropertyObjectReferenceType::Strong))
+			continue;
+
+		bHasObjectReferences = true;
+
+		const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property);
+		if (ObjectProperty && Property->ArrayDim == 1)
+		{
+			ObjectProperties.Add(ObjectProperty);
+		}
+		else
+		{
+			bHasNestedReferences = true;
+		}
+	}
+
+	for (const FPropertyBagPropertyDesc& Desc : InStruct->GetPropertyDescs())
+	{
+		const int32 Index = EAA::Internals::FindCaptureIndex(Desc.Name);
+		if (Index == INDEX_NONE || !Desc.CachedProperty)
+			continue;
+
+		if (Slots.Num() <= Index)
+		{
+			Slots.SetNum(Index + 1);
+		}
+
+		FSlot& Slot = Slots[Index];
+		Slot.Desc = &Desc;
+		Slot.Property = Desc.CachedProperty;
+		Slot.Offset = Desc.CachedProperty->GetOffset_ForInternal();
+	}
+}
+
+TSharedPtr<const FEnhancedAsyncContextLayout> FEnhancedAsyncContextLayout::FindOrAdd(const UPropertyBag* Struct)
+{
+	if (Struct == nullptr)
+	{
+		return nullptr;
+	}
+
+	FEnhancedAsyncContextLayoutCache& Cache = FEnhancedAsyncContextLayoutCache::Get();
+
+	{
+		FReadScopeLock ScopeLock(Cache.Lock);
+		const TSharedPtr<const FEnhancedAsyncContextLayout>* Found = Cache.Layouts.Find(Struct);
+		// address may belong to a collected struct that was not purged yet
+		if (Found && (*Found)->GetStruct() == Struct)
+		{
+			return *Found;
+		}
+	}
+
+	TSharedPtr<const FEnhancedAsyncContextLayout> Layout = MakeShareable(new FEnhancedAsyncContextLayout(Struct));
+
+	FWriteScopeLock ScopeLock(Cache.Lock);
+	Cache.Layouts.Add(Struct, Layout);
+	return Layout;
+}
+
+const UPropertyBag* FEnhancedAsyncContextLayout::FindOrAddDefinition(const FString& Definition, bool& bOutComplete)
+{
+	FEnhancedAsyncContextLayoutCache& Cache = FEnhancedAsyncContextLayoutCache::Get();
+
+	{
+		FReadScopeLock ScopeLock(Cache.DefinitionLock);
+		if (const UPropertyBag* const* Found = Cache.Definitions.Find(Definition))
+		{
+			bOutComplete = true;
+			return *Found;
+		}
+	}
+
+	TArray<FPropertyBagPropertyDesc> Descs;
+	bOutComplete = FEnhancedAsyncActionContext_PropertyBagBase::ParseStringDefinition(Definition, Descs);
+
+	// all properties are resolved into struct at once
+	const UPropertyBag* Struct = Descs.Num() ? UPropertyBag::GetOrCreateFromDescs(Descs) : nullptr;
+
+	if (Struct != nullptr && bOutComplete)
+	{
+		FWriteScopeLock ScopeLock(Cache.DefinitionLock);
+		Cache.Definitions.Add(Definition, Struct);
+	}
+	return Struct;
+}
+
+bool FEnhancedAsyncContextLayout::AddReferencedObjects(void* Memory, FReferenceCollector& Collector) const
+{
+	if (bHasNestedReferences)
+	{
+		return false;
+	}
+
+	for (const FObjectProperty* Property : ObjectProperties)
+	{
+		Collector.AddReferencedObject(*Property->ContainerPtrToValuePtr<TObjectPtr<UObject>>(Memory));
+	}
+	return true;
+}
@@ -0,0 +1,87 @@
+﻿// Copyright 2025, Aquanox.
+
+#pragma once
+
+#include "StructUtils/PropertyBag.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/WeakObjectPtr.h"
+
+#define UE_API ENHANCEDASYNCACTION_API
+
+/**
+ * Traits of a context value layout, derived once per resolved UPropertyBag.
+ *
+ * Contexts whose layout has no strong object references are not visited by garbage collection,
+ * layouts that only hold plain object properties report those properties directly instead of walking whole struct.
+ * Layout struct itself is reported by the layout cache while any context holds the layout.
+ *
+ * Capture properties are mapped to slots by capture index so accessors address value memory without name lookups.
+ */
+class UE_API FEnhancedAsyncContextLayout
+{
+public:
+	/** Capture property of layout */
+	struct FSlot
+	{
+		// Descriptor owned by layout struct
+		const FPropertyBagPropertyDesc* Desc = nullptr;
+		const FProperty* Property = nullptr;
+		int32 Offset = 0;
+
+		bool Matches(EPropertyBagPropertyType Type, const UObject* TypeObject, EPropertyBagContainerType Container = EPropertyBagContainerType::None) const
+		{
+			return Desc->ValueType == Type && Desc->ValueTypeObject == TypeObject && Desc->ContainerTypes.GetFirstContainerType() == Container;
+		}
+	};
+
+	/**
+	 * Find or build layout traits for bag struct
+	 *
+	 * @return shared layout traits, null for empty bag
+	 */
+	static TSharedPtr<const FEnhancedAsyncContextLayout> FindOrAdd(const UPropertyBag* Struct);
+
+	/**
+	 * Find or build bag struct for capture config string.
+	 *
+	 * Config string is parsed once per process, following calls are a single hash lookup.
+	 * Definitions referencing types that are not loaded yet are not cached.
+	 *
+	 * @param bOutComplete set to false if some entry of definition could not be resolved
+	 * @return bag struct, null if definition has no properties
+	 */
+	static const UPropertyBag* FindOrAddDefinition(const FString& Definition, bool& bOutComplete);
+
+	const UPropertyBag* GetStruct() const { return Struct.Get(); }
+
+	/** Layout has properties that hold strong object references */
+	bool HasObjectReferences() const { return bHasObjectReferences; }
+
+	/**
+	 * Report references held by value of this layout
+	 *
+	 * @return false if layout references can not be reported per property and whole struct must be visited
+	 */
+	bool AddReferencedObjects(void* Memory, FReferenceCollector& Collector) const;
+
+	/** Find slot of capture property at index, null if layout has no such capture */
+	const FSlot* FindSlot(int32 Index) const
+	{
+		return Slots.IsValidIndex(Index) && Slots[Index].Desc ? &Slots[Index] : nullptr;
+	}
+
+private:
+	explicit FEnhancedAsyncContextLayout(const UPropertyBag* InStruct);
+
+	// Layout struct, kept alive by the cache only while layout is held outside of it
+	TWeakObjectPtr<const UPropertyBag> Struct;
+	// Strong object properties of layout
+	TArray<const FObjectProperty*> ObjectProperties;
+	bool bHasObjectReferences = false;
+	// Layout holds references in containers or nested structs
+	bool bHasNestedReferences = false;
+	// Capture properties by capture index, gaps are empty
+	TArray<FSlot, TInlineAllocator<8>> Slots;
+};
+
+#undef UE_API
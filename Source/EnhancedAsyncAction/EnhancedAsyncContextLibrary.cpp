@@ -6,6 +6,7 @@
 #include "Engine/Engine.h"
 #include "EnhancedAsyncContextManager.h"
 #include "EnhancedAsyncContextImpl.h"
+#include "EnhancedAsyncContextLayout.h"
 #include "EnhancedAsyncContextShared.h"
 #include "EnhancedAsyncActionHandle.h"
 #include "EnhancedLatentActionHandle.h"
@@ -43,25 +44,150 @@
 
 // =================== RESOLVERS ===========================
 
+/**
+ * Context resolved for the duration of a library call.
+ *
+ * Game thread callers get the context without pinning it, other threads keep the thread-safe path.
+ */
+struct FResolvedContextRef
+{
+	// Context that was just created by the caller, keeps it pinned
+	explicit FResolvedContextRef(TSharedPtr<FEnhancedAsyncActionContext> InContext)
+		: Context(InContext.Get()), Pinned(MoveTemp(InContext))
+	{
+	}
+
+	explicit FResolvedContextRef(const FAsyncContextHandleBase& Handle)
+	{
+		FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+		if (IsInGameThread())
+		{
+			Context = Manager.FindContextOnGameThread(Handle.GetId(), EResolveErrorMode::Fallback);
+		}
+		else
+		{
+			Pinned = Manager.FindContext(Handle, EResolveErrorMode::Fallback);
+			Context = Pinned.Get();
+		}
+	}
+
+	// Context bound to action object, null if there is none
+	FResolvedContextRef(const UObject* Action, FAsyncContextId& OutContextId)
+	{
+		FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+		if (IsInGameThread())
+		{
+			Context = Manager.FindContextOnGameThread(Action, OutContextId);
+		}
+		else
+		{
+			Pinned = Manager.FindContext(Action, OutContextId);
+			Context = Pinned.Get();
+		}
+	}
+
+	bool IsValid() const { return Context != nullptr; }
+
+	FEnhancedAsyncActionContext* operator->() const { return Context; }
+	FEnhancedAsyncActionContext& operator*() const { return *Context; }
+
+private:
+	FEnhancedAsyncActionContext* Context = nullptr;
+	TSharedPtr<FEnhancedAsyncActionContext> Pinned;
+};
+
 template<typename T>
-TSharedRef<FEnhancedAsyncActionContext> ResolveContext(const T& Handle) = delete;
+FResolvedContextRef ResolveContext(const T& Handle) = delete;
 
 template<>
-TSharedRef<FEnhancedAsyncActionContext> ResolveContext(const FAsyncContextHandleBase& Handle)
+FResolvedContextRef ResolveContext(const FAsyncContextHandleBase& Handle)
 {
-	return FEnhancedAsyncContextManager::Get().FindContext(Handle/*.GetId()*/, EResolveErrorMode::Fallback).ToSharedRef();
+	return FResolvedContextRef(Handle);
 }
 
 template<>
-TSharedRef<FEnhancedAsyncActionContext> ResolveContext(const FEnhancedAsyncActionContextHandle& Handle)
+FResolvedContextRef ResolveContext(const FEnhancedAsyncActionContextHandle& Handle)
 {
-	return FEnhancedAsyncContextManager::Get().FindContext(Handle/*.GetId()*/, EResolveErrorMode::Fallback).ToSharedRef();
+	return FResolvedContextRef(Handle);
 }
 
 template<>
-TSharedRef<FEnhancedAsyncActionContext> ResolveContext(const FEnhancedLatentActionContextHandle& Handle)
+FResolvedContextRef ResolveContext(const FEnhancedLatentActionContextHandle& Handle)
+{
+	return FResolvedContextRef(Handle);
+}
+
+// =================== DIAGNOSTICS ===========================
+
+/**
+ * Report failed context access to script, message is only built on this path.
+ */
+static FORCENOINLINE void ThrowAccessError(UObject* Context, FFrame& Stack, EContextAccessResult Result, const TCHAR* Operation, int32 Index, const FProperty* Property, bool bEnsure)
+{
+	const FString Message = FEnhancedAsyncActionContext::DescribeAccessResult(Result, Operation, Index, Property);
+	ensureAlwaysMsgf(!bEnsure, TEXT("%s"), *Message);
+
+	FBlueprintExceptionInfo ExceptionInfo(EBlueprintExceptionType::AbortExecution, FText::FromString(Message));
+	FBlueprintCoreDelegates::ThrowScriptException(Context, Stack, ExceptionInfo);
+}
+
+// =================== BACKEND SELECTION ===========================
+
+/**
+ * Move context that was not set up yet to inline storage if all captures fit it.
+ *
+ * Only fresh pooled bag contexts are moved, containers living in owner memory stay in place.
+ */
+static bool TryMoveToInlineContext(const FAsyncContextHandleBase& Handle, FResolvedContextRef& Context, const FEnhancedAsyncActionContext_Inline::FLayout& Layout)
+{
+	FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+
+	const UObject* Owner = Context->GetOwningObject();
+	FEnhancedAsyncContextArena* Arena = Manager.FindContextArena(Handle.GetId(), Owner);
+
+	TSharedRef<FEnhancedAsyncActionContext_Inline> Inline = FEnhancedAsyncContextArena::MakeContext<FEnhancedAsyncActionContext_Inline>(Arena, Owner, Layout);
+	if (!Manager.ReplaceContext(Handle.GetId(), Inline))
+	{
+		return false;
+	}
+	// previous context is released by manager
+	Context = ResolveContext(Handle);
+	return true;
+}
+
+static bool CanMoveToInlineContext(const FEnhancedAsyncActionContext& Context)
 {
-	return FEnhancedAsyncContextManager::Get().FindContext(Handle/*.GetId()*/, EResolveErrorMode::Fallback).ToSharedRef();
+	return FEnhancedAsyncActionContext_Inline::IsEnabled() && Context.CanSetupContext() && Context.CanRecycle()
+		&& static_cast<const FEnhancedAsyncActionContext_PropertyBag&>(Context).IsEmpty();
+}
+
+static void SetupResolvedContext(const FAsyncContextHandleBase& Handle, FResolvedContextRef& Context, const FString& Config)
+{
+	if (CanMoveToInlineContext(*Context))
+	{
+		bool bComplete;
+		const UPropertyBag* BagStruct = FEnhancedAsyncContextLayout::FindOrAddDefinition(Config, bComplete);
+
+		FEnhancedAsyncActionContext_Inline::FLayout Layout;
+		if (BagStruct && bComplete && Layout.Build(BagStruct->GetPropertyDescs()) && TryMoveToInlineContext(Handle, Context, Layout))
+		{
+			return;
+		}
+	}
+	Context->SetupFromStringDefinition(Config);
+}
+
+static void SetupResolvedContext(const FAsyncContextHandleBase& Handle, FResolvedContextRef& Context, TConstArrayView<TPair<FName, const FProperty*>> Properties)
+{
+	if (CanMoveToInlineContext(*Context))
+	{
+		FEnhancedAsyncActionContext_Inline::FLayout Layout;
+		if (Layout.Build(Properties) && TryMoveToInlineContext(Handle, Context, Layout))
+		{
+			return;
+		}
+	}
+	Context->SetupFromProperties(Properties);
 }
 
 // =================== CORE ===========================
@@ -77,6 +203,48 @@ FEnhancedAsyncActionContextHandle UEnhancedAsyncContextLibrary::CreateContextFor
 	return ValueOrError.GetValue();
 }
 
+FEnhancedAsyncActionContextHandle UEnhancedAsyncContextLibrary::CreateContextForObjectIndexed(const UObject* Action, FName InnerContainerProperty, int32 Captures)
+{
+	checkNoEntry();
+	return FEnhancedAsyncActionContextHandle();
+}
+
+DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execCreateContextForObjectIndexed)
+{
+	P_GET_OBJECT(UObject, Action);
+	P_GET_PROPERTY(FNameProperty, InnerContainerProperty);
+	P_GET_PROPERTY(FIntProperty, CaptureMask);
+
+	FVariadicCaptures Captures;
+	for (uint32 Mask = static_cast<uint32>(CaptureMask); Mask; Mask &= Mask - 1)
+	{
+		StepVariadicCapture(Stack, FMath::CountTrailingZeros(Mask), Captures);
+	}
+
+	P_FINISH;
+
+	P_NATIVE_BEGIN;
+	FEnhancedAsyncActionContextHandle Handle;
+
+	TSharedPtr<FEnhancedAsyncActionContext> Created;
+	auto ValueOrError = FEnhancedAsyncContextManager::Get().CreateContext(Action, InnerContainerProperty, Created);
+	if (ValueOrError.HasError())
+	{
+		UE_LOG(LogEnhancedAction, Warning, TEXT("CreateContextForObject failed for node: %s"), *ValueOrError.GetError());
+	}
+	else
+	{
+		Handle = ValueOrError.GetValue();
+
+		// context is written right away, no lookup by freshly issued handle
+		FResolvedContextRef ContextSafe(MoveTemp(Created));
+		WriteResolvedCaptures(Context, Stack, Handle, ContextSafe, Captures);
+	}
+
+	*static_cast<FEnhancedAsyncActionContextHandle*>(RESULT_PARAM) = Handle;
+	P_NATIVE_END;
+}
+
 FEnhancedLatentActionContextHandle UEnhancedAsyncContextLibrary::CreateContextForLatent(const UObject* Owner, int32 UUID, int32 CallUUID, bool bInitContainer, FEnhancedLatentActionDelegate Delegate)
 {
 	UE_LOG(LogEnhancedAction, Verbose, TEXT("CreateLatent Owner=%s UUID=%d call=%d init=%d"), *GetNameSafe(Owner), UUID, CallUUID, bInitContainer);
@@ -108,7 +276,21 @@ void UEnhancedAsyncContextLibrary::DestroyContextForLatent(const FEnhancedLatent
 
 void UEnhancedAsyncContextLibrary::SetupContextContainer(const FAsyncContextHandleBase& Handle, const FString& Config)
 {
-	ResolveContext(Handle)->SetupFromStringDefinition(Config);
+	FResolvedContextRef Context = ResolveContext(Handle);
+	if (Context->CanSetupContext())
+	{
+		SetupResolvedContext(Handle, Context, Config);
+	}
+}
+
+void UEnhancedAsyncContextLibrary::BeginContextStaging(const FAsyncContextHandleBase& Handle)
+{
+	ResolveContext(Handle)->BeginStaging();
+}
+
+void UEnhancedAsyncContextLibrary::CommitContextStaging(const FAsyncContextHandleBase& Handle)
+{
+	ResolveContext(Handle)->CommitStaging();
 }
 
 FEnhancedAsyncActionContextHandle UEnhancedAsyncContextLibrary::GetContextForObject(const UObject* Action)
@@ -126,7 +308,7 @@ FEnhancedLatentActionContextHandle UEnhancedAsyncContextLibrary::GetContextForLa
 
 void UEnhancedAsyncContextLibrary::DumpContextForObject(const UObject* Action)
 {
-	auto Context = FEnhancedAsyncContextManager::Get().FindContext(FAsyncContextId::Make(Action));
+	auto Context = FEnhancedAsyncContextManager::Get().FindContext(FEnhancedAsyncContextManager::Get().FindContextHandle(Action));
 	if (Context)
 	{
 		FStringBuilderBase Builder;
@@ -219,66 +401,98 @@ void UEnhancedAsyncContextLibrary::Handle_SetValue_Variadic(const FAsyncContextH
 
 DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_SetValue_Variadic)
 {
-	// Read the standard function arguments
-	Stack.MostRecentProperty = nullptr;
-	Stack.MostRecentPropertyAddress = nullptr;
-	Stack.StepCompiledIn<FStructProperty>(nullptr);
-	const FStructProperty* HandleProp = CastField<FStructProperty>(Stack.MostRecentProperty);
-	const FAsyncContextHandleBase* HandlePtr = reinterpret_cast<const FAsyncContextHandleBase*>(Stack.MostRecentPropertyAddress);
+	const FAsyncContextHandleBase* HandlePtr = StepVariadicHandle(Stack);
 
 	P_GET_TARRAY_REF(FString, Parameters);
 
-	struct FInputParam { int32 Index; FName Name; const FProperty* Property; const void* Value;  };
-	TArray<FInputParam, TInlineAllocator<16>> VarInputs;
-	TArray<TPair<FName, const FProperty*>, TInlineAllocator<16>> SetupInputs;
-
-	// Read the input values
-	for (int32 Index = 0; Index < Parameters.Num(); ++Index)
+	FVariadicCaptures Captures;
+	for (const FString& InputName : Parameters)
 	{
-		const FString& InputName = Parameters[Index];
+		StepVariadicCapture(Stack, EAA::Internals::NameToIndex(FName(*InputName)), Captures);
+	}
+
+	P_FINISH;
+
+	WriteValueVariadic(Context, Stack, HandlePtr, Captures);
+}
+
+void UEnhancedAsyncContextLibrary::Handle_SetValue_Indexed(const FAsyncContextHandleBase& Handle, int32 Captures)
+{
+	checkNoEntry();
+}
 
-		Stack.MostRecentProperty = nullptr;
-		Stack.MostRecentPropertyAddress = nullptr;
-		Stack.StepCompiledIn<FProperty>(nullptr);
-		check(Stack.MostRecentProperty && Stack.MostRecentPropertyAddress);
+DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_SetValue_Indexed)
+{
+	const FAsyncContextHandleBase* HandlePtr = StepVariadicHandle(Stack);
 
-		FInputParam& Input = VarInputs.AddDefaulted_GetRef();
-		Input.Name = *InputName;
-		Input.Index = EAA::Internals::NameToIndex(Input.Name);
-		Input.Property = Stack.MostRecentProperty;
-		Input.Value = Stack.MostRecentPropertyAddress;
+	P_GET_PROPERTY(FIntProperty, CaptureMask);
 
-		SetupInputs.Emplace(Input.Name, Input.Property);
+	FVariadicCaptures Captures;
+	for (uint32 Mask = static_cast<uint32>(CaptureMask); Mask; Mask &= Mask - 1)
+	{
+		StepVariadicCapture(Stack, FMath::CountTrailingZeros(Mask), Captures);
 	}
 
 	P_FINISH;
 
-	EAA_KISMET_ENSURE(HandleProp != nullptr && HandlePtr != nullptr, "Failed to resolve the Handle Property for Set Value Variadic");
+	WriteValueVariadic(Context, Stack, HandlePtr, Captures);
+}
+
+const FAsyncContextHandleBase* UEnhancedAsyncContextLibrary::StepVariadicHandle(FFrame& Stack)
+{
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FStructProperty>(nullptr);
+	const FStructProperty* HandleProp = CastField<FStructProperty>(Stack.MostRecentProperty);
+	return HandleProp ? reinterpret_cast<const FAsyncContextHandleBase*>(Stack.MostRecentPropertyAddress) : nullptr;
+}
+
+void UEnhancedAsyncContextLibrary::StepVariadicCapture(FFrame& Stack, int32 Index, FVariadicCaptures& OutCaptures)
+{
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.StepCompiledIn<FProperty>(nullptr);
+	check(Stack.MostRecentProperty && Stack.MostRecentPropertyAddress);
+
+	FVariadicCapture& Capture = OutCaptures.AddDefaulted_GetRef();
+	Capture.Index = Index;
+	Capture.Property = Stack.MostRecentProperty;
+	Capture.Value = Stack.MostRecentPropertyAddress;
+}
+
+void UEnhancedAsyncContextLibrary::WriteValueVariadic(UObject* Context, FFrame& Stack, const FAsyncContextHandleBase* HandlePtr, const FVariadicCaptures& Captures)
+{
+	EAA_KISMET_ENSURE(HandlePtr != nullptr, "Failed to resolve the Handle Property for Set Value Variadic");
 
 	UE_LOG(LogEnhancedAction, Verbose, TEXT("Write context %s"), *HandlePtr->GetDebugString());
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(*HandlePtr, EResolveErrorMode::Fallback);
+	auto ContextSafe = ResolveContext(*HandlePtr);
+	WriteResolvedCaptures(Context, Stack, *HandlePtr, ContextSafe, Captures);
+	P_NATIVE_END;
+}
+
+void UEnhancedAsyncContextLibrary::WriteResolvedCaptures(UObject* Context, FFrame& Stack, const FAsyncContextHandleBase& Handle, FResolvedContextRef& ContextSafe, const FVariadicCaptures& Captures)
+{
 	if (ContextSafe->CanSetupContext())
 	{
-		ContextSafe->SetupFromProperties(SetupInputs);
+		TArray<TPair<FName, const FProperty*>, TInlineAllocator<EAA::Internals::MaxCapturePins>> SetupInputs;
+		for (const FVariadicCapture& Input : Captures)
+		{
+			SetupInputs.Emplace(EAA::Internals::IndexToName(Input.Index), Input.Property);
+		}
+		SetupResolvedContext(Handle, ContextSafe, SetupInputs);
 	}
 
-	for (const FInputParam& Input : VarInputs)
+	for (const FVariadicCapture& Input : Captures)
 	{
-		FString Message;
-		if (!ensureAlways(ContextSafe->SetValueByName(Input.Name, Input.Property, Input.Value, Message)))
+		const EContextAccessResult Result = ContextSafe->SetValueByIndex(Input.Index, Input.Property, Input.Value);
+		FEnhancedAsyncActionContext::RecordAccessResult(Result);
+		if (UNLIKELY(Result != EContextAccessResult::Success))
 		{
-			auto PropertyContainerString = UEnum::GetValueAsString(EAA::Internals::GetContainerTypeFromProperty(Input.Property));
-			auto PropertyTypeString = UEnum::GetValueAsString(EAA::Internals::GetValueTypeFromProperty(Input.Property));
-			FBlueprintExceptionInfo ExceptionInfo(EBlueprintExceptionType::AbortExecution, FText::FromString(
-				FString::Printf(TEXT("Failed to set context property at index %d (%s:%s) : %s"),
-					Input.Index, *PropertyContainerString, *PropertyTypeString, *Message )
-			) );
-			FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
+			ThrowAccessError(Context, Stack, Result, TEXT("set"), Input.Index, Input.Property, true);
 		}
 	}
-	P_NATIVE_END;
 }
 
 void UEnhancedAsyncContextLibrary::Handle_SetValue_Generic(const FAsyncContextHandleBase& Handle, int32 Index, const int32& Value)
@@ -305,13 +519,13 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_SetValue_Generic)
 	EAA_KISMET_ENSURE(ValueProp != nullptr && ValuePtr != nullptr, "Failed to resolve the Value Property for Set Value Basic");
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 
-	FString Message;
-	if (!ensureAlways(ContextSafe->SetValueByIndex(ParamIndex, ValueProp, ValuePtr, Message)))
+	const EContextAccessResult Result = ContextSafe->SetValueByIndex(ParamIndex, ValueProp, ValuePtr);
+	FEnhancedAsyncActionContext::RecordAccessResult(Result);
+	if (UNLIKELY(Result != EContextAccessResult::Success))
 	{
-		FBlueprintExceptionInfo ExceptionInfo(EBlueprintExceptionType::AbortExecution,  FText::FromString(Message) );
-		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
+		ThrowAccessError(Context, Stack, Result, TEXT("set"), ParamIndex, ValueProp, true);
 	}
 	P_NATIVE_END;
 }
@@ -337,7 +551,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_SetValue_Enum)
 	EAA_KISMET_ENSURE(ParamValueProp != nullptr, "Failed to resolve the Value Property for Set Value Enum");
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	ContextSafe->SetValueEnum(ParamIndex, ParamValueProp->GetEnum(),  ParamValue);
 	P_NATIVE_END;
 }
@@ -364,7 +578,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_SetValue_Struct)
 	EAA_KISMET_ENSURE(ParamValueProp != nullptr && ParamValue != nullptr, "Failed to resolve the Value Property for Set Value Struct");
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	ContextSafe->SetValueStruct(ParamIndex, ParamValueProp->Struct, (const uint8*)ParamValue);
 	P_NATIVE_END;
 }
@@ -385,7 +599,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_SetValue_Object)
 	EAA_KISMET_ENSURE(ParamValueProp != nullptr, "Failed to resolve the Value Property for Set Value Object");
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	ContextSafe->SetValueObject(ParamIndex, ParamValueProp->PropertyClass, ParamValue);
 	P_NATIVE_END;
 }
@@ -406,7 +620,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_SetValue_SoftObject)
 	EAA_KISMET_ENSURE(ParamValueProp != nullptr, "Failed to resolve the Value Property for Set Value Soft Object");
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	ContextSafe->SetValueSoftObject(ParamIndex, ParamValueProp->PropertyClass, ParamValue);
 	P_NATIVE_END;
 }
@@ -427,7 +641,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_SetValue_Class)
 	EAA_KISMET_ENSURE(ParamValueProp != nullptr, "Failed to resolve the Value Property for Set Value Class");
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	ContextSafe->SetValueClass(ParamIndex, ParamValueProp->MetaClass, ParamValue);
 	P_NATIVE_END;
 }
@@ -448,7 +662,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_SetValue_SoftClass)
 	EAA_KISMET_ENSURE(ParamValueProp != nullptr, "Failed to resolve the Value Property for Set Value Class");
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	ContextSafe->SetValueSoftClass(ParamIndex, ParamValueProp->MetaClass, ParamValue);
 	P_NATIVE_END;
 }
@@ -481,7 +695,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_SetValue_Array)
 	}
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	auto ValueType = EAA::Internals::GetValueTypeFromProperty(ArrayProperty);
 	auto ValueTypeObject = EAA::Internals::GetValueTypeObjectFromProperty(ArrayProperty);
 
@@ -518,7 +732,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_SetValue_Set)
 	}
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	auto ValueType = EAA::Internals::GetValueTypeFromProperty(SetProperty);
 	auto ValueTypeObject = EAA::Internals::GetValueTypeObjectFromProperty(SetProperty);
 
@@ -528,6 +742,43 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_SetValue_Set)
 	P_NATIVE_END;
 }
 
+void UEnhancedAsyncContextLibrary::Handle_SetValue_Map(const FAsyncContextHandleBase& Handle, int32 Index, const TMap<int32, int32>& Value)
+{
+	checkNoEntry();
+}
+
+DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_SetValue_Map)
+{
+	P_GET_STRUCT_REF(FAsyncContextHandleBase,ParamHandle);
+	P_GET_PROPERTY(FIntProperty,ParamIndex);
+
+	// Read wildcard Value input.
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.MostRecentPropertyContainer = nullptr;
+	Stack.StepCompiledIn<FMapProperty>(nullptr);
+
+	const FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+	const void* MapAddr = Stack.MostRecentPropertyAddress;
+	P_FINISH;
+
+	if (MapProperty == nullptr || MapAddr == nullptr)
+	{
+		Stack.bArrayContextFailed = true;
+		return;
+	}
+
+	P_NATIVE_BEGIN;
+	auto ContextSafe = ResolveContext(ParamHandle);
+	const EContextAccessResult Result = ContextSafe->SetValueByIndex(ParamIndex, MapProperty, MapAddr);
+	FEnhancedAsyncActionContext::RecordAccessResult(Result);
+	if (UNLIKELY(Result != EContextAccessResult::Success))
+	{
+		ThrowAccessError(Context, Stack, Result, TEXT("set"), ParamIndex, MapProperty, false);
+	}
+	P_NATIVE_END;
+}
+
 // ==================== GETTERS =========================
 
 void UEnhancedAsyncContextLibrary::Handle_GetValue_Bool(const FAsyncContextHandleBase& Handle, int32 Index, bool& Value)
@@ -582,58 +833,157 @@ void UEnhancedAsyncContextLibrary::Handle_GetValue_Variadic(const FAsyncContextH
 
 DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_GetValue_Variadic)
 {
-	// Read the standard function arguments
-	Stack.MostRecentProperty = nullptr;
-	Stack.MostRecentPropertyAddress = nullptr;
-	Stack.StepCompiledIn<FStructProperty>(nullptr);
-	const FStructProperty* HandleProp = CastField<FStructProperty>(Stack.MostRecentProperty);
-	const FAsyncContextHandleBase* HandlePtr = reinterpret_cast<const FAsyncContextHandleBase*>(Stack.MostRecentPropertyAddress);
+	ReadValueVariadicNames(Context, Stack, false);
+}
+
+void UEnhancedAsyncContextLibrary::Handle_ConsumeValue_Variadic(const FAsyncContextHandleBase& Handle, const TArray<FString>& Names)
+{
+	checkNoEntry();
+}
+
+DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_ConsumeValue_Variadic)
+{
+	ReadValueVariadicNames(Context, Stack, true);
+}
+
+void UEnhancedAsyncContextLibrary::Handle_GetValue_Indexed(const FAsyncContextHandleBase& Handle, int32 Captures)
+{
+	checkNoEntry();
+}
 
-    P_GET_TARRAY_REF(FString, Parameters);
+DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_GetValue_Indexed)
+{
+	ReadValueVariadicIndexed(Context, Stack, false);
+}
 
-    struct FOutputParam { int32 Index; FName Name; const FProperty* Property; void* Value;  };
-    TArray<FOutputParam, TInlineAllocator<16>> VarOutputs;
+void UEnhancedAsyncContextLibrary::Handle_ConsumeValue_Indexed(const FAsyncContextHandleBase& Handle, int32 Captures)
+{
+	checkNoEntry();
+}
 
-    // Read the input values and write them to the Python context
-    for (int32 Index = 0; Index < Parameters.Num(); ++Index)
-    {
-    	const FString& InputName = Parameters[Index];
+DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_ConsumeValue_Indexed)
+{
+	ReadValueVariadicIndexed(Context, Stack, true);
+}
 
-    	Stack.MostRecentProperty = nullptr;
-    	Stack.MostRecentPropertyAddress = nullptr;
-    	Stack.StepCompiledIn<FProperty>(nullptr);
-    	check(Stack.MostRecentProperty && Stack.MostRecentPropertyAddress);
+void UEnhancedAsyncContextLibrary::ReadValueVariadicNames(UObject* Context, FFrame& Stack, bool bConsume)
+{
+	const FAsyncContextHandleBase* HandlePtr = StepVariadicHandle(Stack);
 
-    	FOutputParam& Output = VarOutputs.AddDefaulted_GetRef();
-    	Output.Name = *InputName;
-    	Output.Index = EAA::Internals::NameToIndex(Output.Name);
-    	Output.Property = Stack.MostRecentProperty;
-    	Output.Value = Stack.MostRecentPropertyAddress;
-    }
+	P_GET_TARRAY_REF(FString, Parameters);
+
+	FVariadicCaptures Captures;
+	for (const FString& InputName : Parameters)
+	{
+		StepVariadicCapture(Stack, EAA::Internals::NameToIndex(FName(*InputName)), Captures);
+	}
 
-    P_FINISH;
+	P_FINISH;
+
+	ReadValueVariadic(Context, Stack, HandlePtr, Captures, bConsume);
+}
 
-	EAA_KISMET_ENSURE(HandleProp != nullptr && HandlePtr != nullptr, "Failed to resolve the Handle Property for Get Value Variadic");
+void UEnhancedAsyncContextLibrary::ReadValueVariadicIndexed(UObject* Context, FFrame& Stack, bool bConsume)
+{
+	const FAsyncContextHandleBase* HandlePtr = StepVariadicHandle(Stack);
+
+	P_GET_PROPERTY(FIntProperty, CaptureMask);
+
+	FVariadicCaptures Captures;
+	for (uint32 Mask = static_cast<uint32>(CaptureMask); Mask; Mask &= Mask - 1)
+	{
+		StepVariadicCapture(Stack, FMath::CountTrailingZeros(Mask), Captures);
+	}
+
+	P_FINISH;
+
+	ReadValueVariadic(Context, Stack, HandlePtr, Captures, bConsume);
+}
+
+void UEnhancedAsyncContextLibrary::ReadValueVariadic(UObject* Context, FFrame& Stack, const FAsyncContextHandleBase* HandlePtr, const FVariadicCaptures& Captures, bool bConsume)
+{
+	EAA_KISMET_ENSURE(HandlePtr != nullptr, "Failed to resolve the Handle Property for Get Value Variadic");
 
 	UE_LOG(LogEnhancedAction, Verbose, TEXT("Read context %s"), *HandlePtr->GetDebugString());
 
-    P_NATIVE_BEGIN;
-    auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(*HandlePtr, EResolveErrorMode::Fallback);
-	for (const FOutputParam& Input : VarOutputs)
+	P_NATIVE_BEGIN;
+	auto ContextSafe = ResolveContext(*HandlePtr);
+	ReadResolvedCaptures(Context, Stack, ContextSafe, Captures, bConsume);
+
+	if (bConsume)
+	{ // context is spent, release it now instead of waiting for owner deletion
+		FEnhancedAsyncContextManager::Get().DestroyContext(HandlePtr->GetId());
+	}
+	P_NATIVE_END;
+}
+
+void UEnhancedAsyncContextLibrary::Action_GetValue_Indexed(const UObject* Action, int32 Captures)
+{
+	checkNoEntry();
+}
+
+DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execAction_GetValue_Indexed)
+{
+	ReadActionValueIndexed(Context, Stack, false);
+}
+
+void UEnhancedAsyncContextLibrary::Action_ConsumeValue_Indexed(const UObject* Action, int32 Captures)
+{
+	checkNoEntry();
+}
+
+DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execAction_ConsumeValue_Indexed)
+{
+	ReadActionValueIndexed(Context, Stack, true);
+}
+
+void UEnhancedAsyncContextLibrary::ReadActionValueIndexed(UObject* Context, FFrame& Stack, bool bConsume)
+{
+	P_GET_OBJECT(UObject, Action);
+	P_GET_PROPERTY(FIntProperty, CaptureMask);
+
+	FVariadicCaptures Captures;
+	for (uint32 Mask = static_cast<uint32>(CaptureMask); Mask; Mask &= Mask - 1)
 	{
-		FString Message;
-		if (!ensureAlways(ContextSafe->GetValueByName(Input.Name, Input.Property, Input.Value, Message)))
+		StepVariadicCapture(Stack, FMath::CountTrailingZeros(Mask), Captures);
+	}
+
+	P_FINISH;
+
+	// single owner lookup, no public handle is built
+	FAsyncContextId ContextId;
+	FResolvedContextRef ContextSafe(IsValid(Action) ? Action : nullptr, ContextId);
+	if (!ContextSafe.IsValid())
+	{ // context expired, was consumed or released with its owner, outputs keep their defaults
+		UE_LOG(LogEnhancedAction, Verbose, TEXT("No context to read for %s"), *GetNameSafe(Action));
+		return;
+	}
+
+	UE_LOG(LogEnhancedAction, Verbose, TEXT("Read context %s"), *GetNameSafe(Action));
+
+	P_NATIVE_BEGIN;
+	ReadResolvedCaptures(Context, Stack, ContextSafe, Captures, bConsume);
+
+	if (bConsume)
+	{ // context is spent, release it now instead of waiting for owner deletion
+		FEnhancedAsyncContextManager::Get().DestroyContext(ContextId);
+	}
+	P_NATIVE_END;
+}
+
+void UEnhancedAsyncContextLibrary::ReadResolvedCaptures(UObject* Context, FFrame& Stack, FResolvedContextRef& ContextSafe, const FVariadicCaptures& Captures, bool bConsume)
+{
+	for (const FVariadicCapture& Input : Captures)
+	{
+		const EContextAccessResult Result = bConsume
+			? ContextSafe->ConsumeValueByIndex(Input.Index, Input.Property, Input.Value)
+			: ContextSafe->GetValueByIndex(Input.Index, Input.Property, Input.Value);
+		FEnhancedAsyncActionContext::RecordAccessResult(Result);
+		if (UNLIKELY(Result != EContextAccessResult::Success))
 		{
-			auto PropertyContainerString = UEnum::GetValueAsString(EAA::Internals::GetContainerTypeFromProperty(Input.Property));
-			auto PropertyTypeString = UEnum::GetValueAsString(EAA::Internals::GetValueTypeFromProperty(Input.Property));
-			FBlueprintExceptionInfo ExceptionInfo(EBlueprintExceptionType::AbortExecution, FText::FromString(
-				FString::Printf(TEXT("Failed to get context property at index %d (%s:%s) : %s"),
-					Input.Index, *PropertyContainerString, *PropertyTypeString, *Message )
-			) );
-			FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
+			ThrowAccessError(Context, Stack, Result, TEXT("get"), Input.Index, Input.Property, true);
 		}
 	}
-    P_NATIVE_END;
 }
 
 void UEnhancedAsyncContextLibrary::Handle_GetValue_Generic(const FAsyncContextHandleBase& Handle, int32 Index, int32& Value)
@@ -660,13 +1010,13 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_GetValue_Generic)
 
 	P_NATIVE_BEGIN;
 
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 
-	FString Message;
-	if (!ensureAlways(ContextSafe->GetValueByIndex(ParamIndex, ValueProp, ValuePtr, Message)))
+	const EContextAccessResult Result = ContextSafe->GetValueByIndex(ParamIndex, ValueProp, ValuePtr);
+	FEnhancedAsyncActionContext::RecordAccessResult(Result);
+	if (UNLIKELY(Result != EContextAccessResult::Success))
 	{
-		FBlueprintExceptionInfo ExceptionInfo(EBlueprintExceptionType::AbortExecution,  FText::FromString(Message) );
-		FBlueprintCoreDelegates::ThrowScriptException(P_THIS, Stack, ExceptionInfo);
+		ThrowAccessError(Context, Stack, Result, TEXT("get"), ParamIndex, ValueProp, true);
 	}
 
 	P_NATIVE_END;
@@ -694,7 +1044,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_GetValue_Enum)
 	EAA_KISMET_ENSURE(ParamValueProp != nullptr, "Unsupported property type the Value for Set Value Enum");
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	ContextSafe->GetValueEnum(ParamIndex, ParamValueProp->GetEnum(), ParamValue);
 	P_NATIVE_END;
 }
@@ -722,7 +1072,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_GetValue_Struct)
 	EAA_KISMET_ENSURE(ParamValueProp != nullptr && ParamValue != nullptr, "Unsupported property type the Value for Set Value Struct");
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	const uint8* Result = nullptr;
 	ContextSafe->GetValueStruct(ParamIndex, ParamValueProp->Struct, Result);
 	if (Result)
@@ -732,6 +1082,20 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_GetValue_Struct)
 	P_NATIVE_END;
 }
 
+FConstStructView UEnhancedAsyncContextLibrary::GetValueStructView(const FAsyncContextHandleBase& Handle, int32 Index, UScriptStruct* ExpectedType)
+{
+	// other threads would keep the context alive only for the duration of this call
+	if (!ensureMsgf(IsInGameThread(), TEXT("GetValueStructView is only available on game thread")) || !ExpectedType)
+	{
+		return FConstStructView();
+	}
+
+	auto ContextSafe = ResolveContext(Handle);
+	const uint8* Result = nullptr;
+	ContextSafe->GetValueStruct(Index, ExpectedType, Result);
+	return Result ? FConstStructView(ExpectedType, Result) : FConstStructView();
+}
+
 void UEnhancedAsyncContextLibrary::Handle_GetValue_Object(const FAsyncContextHandleBase& Handle, int32 Index, UObject*& Value)
 {
 	checkNoEntry();
@@ -748,7 +1112,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_GetValue_Object)
 	EAA_KISMET_ENSURE(ParamValueProp != nullptr, "Unsupported property type the Value for Set Value Object");
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	ContextSafe->GetValueObject(ParamIndex, ParamValueProp->PropertyClass, P_ARG_GC_BARRIER(ParamValue));
 	P_NATIVE_END;
 }
@@ -769,7 +1133,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_GetValue_SoftObject)
 	EAA_KISMET_ENSURE(ParamValueProp != nullptr, "Unsupported property type the Value for Get Value Soft Object");
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	ContextSafe->GetValueSoftObject(ParamIndex, ParamValueProp->PropertyClass, ParamValue);
 	P_NATIVE_END;
 }
@@ -790,7 +1154,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_GetValue_Class)
 	EAA_KISMET_ENSURE(ParamValueProp != nullptr, "Unsupported property type the Value for Set Value Class");
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	ContextSafe->GetValueClass(ParamIndex, ParamValueProp->MetaClass, P_ARG_GC_BARRIER(ParamValue));
 	P_NATIVE_END;
 }
@@ -811,7 +1175,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_GetValue_SoftClass)
 	EAA_KISMET_ENSURE(ParamValueProp != nullptr, "Unsupported property type the Value for Get Value Soft Class");
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	ContextSafe->GetValueSoftClass(ParamIndex, ParamValueProp->MetaClass, ParamValue);
 	P_NATIVE_END;
 }
@@ -844,7 +1208,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_GetValue_Array)
 	}
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	auto ValueType = EAA::Internals::GetValueTypeFromProperty(ArrayProperty);
 	auto ValueTypeObject = EAA::Internals::GetValueTypeObjectFromProperty(ArrayProperty);
 
@@ -882,7 +1246,7 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_GetValue_Set)
 	}
 
 	P_NATIVE_BEGIN;
-	auto ContextSafe = FEnhancedAsyncContextManager::Get().FindContext(ParamHandle);
+	auto ContextSafe = ResolveContext(ParamHandle);
 	auto ValueType = EAA::Internals::GetValueTypeFromProperty(SetProperty);
 	auto ValueTypeObject = EAA::Internals::GetValueTypeObjectFromProperty(SetProperty);
 
@@ -892,5 +1256,42 @@ DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_GetValue_Set)
 	P_NATIVE_END;
 }
 
+void UEnhancedAsyncContextLibrary::Handle_GetValue_Map(const FAsyncContextHandleBase& Handle, int32 Index, TMap<int32, int32>& Value)
+{
+	checkNoEntry();
+}
+
+DEFINE_FUNCTION(UEnhancedAsyncContextLibrary::execHandle_GetValue_Map)
+{
+	P_GET_STRUCT_REF(FAsyncContextHandleBase,ParamHandle);
+	P_GET_PROPERTY(FIntProperty,ParamIndex);
+
+	// Read wildcard Value input.
+	Stack.MostRecentProperty = nullptr;
+	Stack.MostRecentPropertyAddress = nullptr;
+	Stack.MostRecentPropertyContainer = nullptr;
+	Stack.StepCompiledIn<FMapProperty>(nullptr);
+
+	const FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+	void* MapAddr = Stack.MostRecentPropertyAddress;
+	P_FINISH;
+
+	if (MapProperty == nullptr || MapAddr == nullptr)
+	{
+		Stack.bArrayContextFailed = true;
+		return;
+	}
+
+	P_NATIVE_BEGIN;
+	auto ContextSafe = ResolveContext(ParamHandle);
+	const EContextAccessResult Result = ContextSafe->GetValueByIndex(ParamIndex, MapProperty, MapAddr);
+	FEnhancedAsyncActionContext::RecordAccessResult(Result);
+	if (UNLIKELY(Result != EContextAccessResult::Success))
+	{
+		ThrowAccessError(Context, Stack, Result, TEXT("get"), ParamIndex, MapProperty, false);
+	}
+	P_NATIVE_END;
+}
+
 #undef EAA_KISMET_ARRAY_ENSURE
 #undef EAA_KISMET_ENSURE
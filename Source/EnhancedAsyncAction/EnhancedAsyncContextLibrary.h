@@ -4,8 +4,12 @@
 
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "EnhancedAsyncContextHandle.h"
+#include "EnhancedAsyncContextShared.h"
+#include "StructUtils/StructView.h"
 #include "EnhancedAsyncContextLibrary.generated.h"
 
+struct FResolvedContextRef;
+
 #define UE_API ENHANCEDASYNCACTION_API
 
 struct FEnhancedAsyncActionContextHandle;
@@ -32,6 +36,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category="EnhancedAsyncAction|Core", meta=(BlueprintInternalUseOnly=true, AdvancedDisplay=1))
 	static UE_API FEnhancedAsyncActionContextHandle CreateContextForObject(const UObject* Action, FName InnerContainerProperty = NAME_None);
 
+	/**
+	 * Create capture context for async action and write captured values in one call. Called by UK2Node_EnhancedAsyncTaskBase.
+	 *
+	 * Variadic values follow in ascending capture index order.
+	 *
+	 * @param Action Action proxy object
+	 * @param InnerContainerProperty Name of container property (none for default)
+	 * @param Captures Bit mask of written capture indices
+	 *
+	 * @return Context handle
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="EnhancedAsyncAction|Core", meta=(Variadic, BlueprintInternalUseOnly=true))
+	static UE_API FEnhancedAsyncActionContextHandle CreateContextForObjectIndexed(const UObject* Action, FName InnerContainerProperty, int32 Captures);
+
+	DECLARE_FUNCTION(execCreateContextForObjectIndexed);
+
 	/**
 	 * Create capture context handle for latent function. Called by UK2Node_EnhancedCallLatentFunction.
 	 *
@@ -63,6 +83,24 @@ public:
 	UFUNCTION(BlueprintCallable, Category="EnhancedAsyncAction|Core", meta=(BlueprintInternalUseOnly=true))
 	static UE_API void SetupContextContainer(const FAsyncContextHandleBase& Handle, const FString& Config);
 
+	/**
+	 * Start collecting captures that are not declared in context yet.
+	 *
+	 * Following setters of new captures are deferred until CommitContextStaging, which declares all of them at once.
+	 *
+	 * @param Handle Context handle
+	 */
+	UFUNCTION(BlueprintCallable, Category="EnhancedAsyncAction|Core", meta=(BlueprintInternalUseOnly=true))
+	static UE_API void BeginContextStaging(const FAsyncContextHandleBase& Handle);
+
+	/**
+	 * Declare captures collected since BeginContextStaging with a single layout build and write their values.
+	 *
+	 * @param Handle Context handle
+	 */
+	UFUNCTION(BlueprintCallable, Category="EnhancedAsyncAction|Core", meta=(BlueprintInternalUseOnly=true))
+	static UE_API void CommitContextStaging(const FAsyncContextHandleBase& Handle);
+
 	/**
 	 * Acquire capture context handle for async action and check validity.
 	 *
@@ -147,6 +185,12 @@ public:
 
 	DECLARE_FUNCTION(execHandle_SetValue_Variadic);
 
+	/** Variadic setter addressing captures by bit mask of capture indices, variadic values follow in ascending index order */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="EnhancedAsyncAction|Setters", DisplayName="Set Value Indexed", meta=(Variadic, BlueprintInternalUseOnly=true, CustomStructureParam="Handle"))
+	static UE_API void Handle_SetValue_Indexed(const FAsyncContextHandleBase& Handle, int32 Captures);
+
+	DECLARE_FUNCTION(execHandle_SetValue_Indexed);
+
 	UFUNCTION(BlueprintCallable, CustomThunk, Category="EnhancedAsyncAction|Getters", DisplayName="Set Generic Value", meta=(BlueprintInternalUseOnly=true, CustomStructureParam="Value"))
 	static UE_API void Handle_SetValue_Generic(const FAsyncContextHandleBase& Handle, int32 Index, const int32& Value);
 
@@ -192,6 +236,11 @@ public:
 
 	DECLARE_FUNCTION(execHandle_SetValue_Set);
 
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="EnhancedAsyncAction|Setters", DisplayName="Set Map Value", meta=(BlueprintInternalUseOnly=true, MapParam="Value"))
+	static UE_API void Handle_SetValue_Map(const FAsyncContextHandleBase& Handle, int32 Index, const TMap<int32, int32>& Value);
+
+	DECLARE_FUNCTION(execHandle_SetValue_Map);
+
 	// ======== GETTERS [ GENERIC ] ============
 
 	UFUNCTION(BlueprintCallable, Category="EnhancedAsyncAction|Getters", DisplayName="Get Bool Value", meta=(BlueprintInternalUseOnly=true))
@@ -228,6 +277,33 @@ public:
 
 	DECLARE_FUNCTION(execHandle_GetValue_Variadic);
 
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="EnhancedAsyncAction|Getters", DisplayName="Consume Value Variadic", meta=(Variadic, BlueprintInternalUseOnly=true, CustomStructureParam="Handle"))
+	static UE_API void Handle_ConsumeValue_Variadic(const FAsyncContextHandleBase& Handle, const TArray<FString>& Names);
+
+	DECLARE_FUNCTION(execHandle_ConsumeValue_Variadic);
+
+	/** Variadic getter addressing captures by bit mask of capture indices, variadic values follow in ascending index order */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="EnhancedAsyncAction|Getters", DisplayName="Get Value Indexed", meta=(Variadic, BlueprintInternalUseOnly=true, CustomStructureParam="Handle"))
+	static UE_API void Handle_GetValue_Indexed(const FAsyncContextHandleBase& Handle, int32 Captures);
+
+	DECLARE_FUNCTION(execHandle_GetValue_Indexed);
+
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="EnhancedAsyncAction|Getters", DisplayName="Consume Value Indexed", meta=(Variadic, BlueprintInternalUseOnly=true, CustomStructureParam="Handle"))
+	static UE_API void Handle_ConsumeValue_Indexed(const FAsyncContextHandleBase& Handle, int32 Captures);
+
+	DECLARE_FUNCTION(execHandle_ConsumeValue_Indexed);
+
+	/** Variadic getter finding context of async action itself, variadic values are written straight into passed references, references are left untouched if action has no context */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="EnhancedAsyncAction|Getters", DisplayName="Get Action Value Indexed", meta=(Variadic, BlueprintInternalUseOnly=true))
+	static UE_API void Action_GetValue_Indexed(const UObject* Action, int32 Captures);
+
+	DECLARE_FUNCTION(execAction_GetValue_Indexed);
+
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="EnhancedAsyncAction|Getters", DisplayName="Consume Action Value Indexed", meta=(Variadic, BlueprintInternalUseOnly=true))
+	static UE_API void Action_ConsumeValue_Indexed(const UObject* Action, int32 Captures);
+
+	DECLARE_FUNCTION(execAction_ConsumeValue_Indexed);
+
 	UFUNCTION(BlueprintCallable, CustomThunk, Category="EnhancedAsyncAction|Getters", DisplayName="Get Generic Value", meta=(BlueprintInternalUseOnly=true, CustomStructureParam="Value"))
 	static UE_API void Handle_GetValue_Generic(const FAsyncContextHandleBase& Handle, int32 Index, int32& Value);
 
@@ -272,6 +348,39 @@ public:
 	static UE_API void Handle_GetValue_Set(const FAsyncContextHandleBase& Handle, int32 Index, TSet<int32>& Value);
 
 	DECLARE_FUNCTION(execHandle_GetValue_Set);
+
+	UFUNCTION(BlueprintCallable, CustomThunk, Category="EnhancedAsyncAction|Getters", DisplayName="Get Map Value", meta=(BlueprintInternalUseOnly=true, MapParam="Value"))
+	static UE_API void Handle_GetValue_Map(const FAsyncContextHandleBase& Handle, int32 Index, TMap<int32, int32>& Value);
+
+	DECLARE_FUNCTION(execHandle_GetValue_Map);
+
+	/**
+	 * Read-only view of captured struct for native code, nothing is copied.
+	 * View points into context memory or into immutable payload shared with other contexts,
+	 * it stays valid until the capture is overwritten or the context is destroyed.
+	 * Only available on game thread.
+	 */
+	static UE_API FConstStructView GetValueStructView(const FAsyncContextHandleBase& Handle, int32 Index, UScriptStruct* ExpectedType);
+
+private:
+	static_assert(EAA::Internals::MaxCapturePins <= 32, "Indexed variadic accessors address captures with 32 bit mask");
+
+	struct FVariadicCapture { int32 Index; const FProperty* Property; void* Value; };
+	using FVariadicCaptures = TArray<FVariadicCapture, TInlineAllocator<EAA::Internals::MaxCapturePins>>;
+
+	// Steps over the handle and variadic value arguments of variadic thunks
+	static const FAsyncContextHandleBase* StepVariadicHandle(FFrame& Stack);
+	static void StepVariadicCapture(FFrame& Stack, int32 Index, FVariadicCaptures& OutCaptures);
+
+	static void WriteValueVariadic(UObject* Context, FFrame& Stack, const FAsyncContextHandleBase* HandlePtr, const FVariadicCaptures& Captures);
+	static void WriteResolvedCaptures(UObject* Context, FFrame& Stack, const FAsyncContextHandleBase& Handle, FResolvedContextRef& ContextSafe, const FVariadicCaptures& Captures);
+
+	// Shared thunk of variadic getters, consuming read moves values out and releases the context
+	static void ReadValueVariadicNames(UObject* Context, FFrame& Stack, bool bConsume);
+	static void ReadValueVariadicIndexed(UObject* Context, FFrame& Stack, bool bConsume);
+	static void ReadValueVariadic(UObject* Context, FFrame& Stack, const FAsyncContextHandleBase* HandlePtr, const FVariadicCaptures& Captures, bool bConsume);
+	static void ReadActionValueIndexed(UObject* Context, FFrame& Stack, bool bConsume);
+	static void ReadResolvedCaptures(UObject* Context, FFrame& Stack, FResolvedContextRef& ContextSafe, const FVariadicCaptures& Captures, bool bConsume);
 };
 
 #undef UE_API
@@ -4,22 +4,48 @@
 
 #include "EnhancedAsyncContext.h"
 #include "EnhancedAsyncContextImpl.h"
+#include "EnhancedAsyncContextSettings.h"
 #include "EnhancedAsyncActionHandle.h"
 #include "EnhancedLatentActionHandle.h"
+#include "Engine/World.h"
 #include "Misc/CoreDelegates.h"
 #include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "UObject/UObjectGlobals.h"
+
+static bool GSkipContextsWithoutReferences = true;
+static FAutoConsoleVariableRef CVarSkipContextsWithoutReferences(
+	TEXT("EnhancedAsyncAction.GC.SkipContextsWithoutReferences"),
+	GSkipContextsWithoutReferences,
+	TEXT("Report to garbage collection only contexts whose layout holds object references. When disabled every context is visited."));
 
 FEnhancedAsyncContextManager::FEnhancedAsyncContextManager()
 	: DummyContext(MakeShared<FEnhancedAsyncActionContextStub>())
 {
 	FCoreDelegates::OnExit.AddRaw(this, &FEnhancedAsyncContextManager::OnShutdown);
+	FCoreDelegates::OnEndFrame.AddRaw(this, &FEnhancedAsyncContextManager::FlushPendingTeardown);
+	FCoreDelegates::OnEndFrame.AddRaw(this, &FEnhancedAsyncContextManager::FlushDeferredReleases);
+	FCoreUObjectDelegates::GetPostPurgeGarbageDelegate().AddRaw(this, &FEnhancedAsyncContextManager::FlushPendingTeardown);
+	FWorldDelegates::OnWorldCleanup.AddRaw(this, &FEnhancedAsyncContextManager::OnWorldCleanup);
+	ReaperTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FEnhancedAsyncContextManager::TickReaper));
+
+	Partitions[GlobalPartition].store(new FContextPartition(), std::memory_order_release);
+	NumAllocatedPartitions = 1;
 }
 
 FEnhancedAsyncContextManager::~FEnhancedAsyncContextManager()
 {
-	ensure(ActionContexts.Num() == 0);
+	ensure(NumContexts.load() == 0);
 	ensure(!ObjectCollector.IsValid());
 	//ObjectListener.DisableListener();
+
+	for (std::atomic<FContextPartition*>& Partition : Partitions)
+	{
+		delete Partition.exchange(nullptr);
+	}
 }
 
 FEnhancedAsyncContextManager& FEnhancedAsyncContextManager::Get()
@@ -28,20 +54,216 @@ FEnhancedAsyncContextManager& FEnhancedAsyncContextManager::Get()
 	return Manager;
 }
 
+const UWorld* FEnhancedAsyncContextManager::GetOwnerWorld(const UObject* Owner)
+{
+	if (const UWorld* World = Cast<UWorld>(Owner))
+	{
+		return World;
+	}
+	// resolved through outer chain unless object overrides it
+	return Owner ? Owner->GetWorld() : nullptr;
+}
+
+FEnhancedAsyncContextManager::FContextShard* FEnhancedAsyncContextManager::FindShard(const FAsyncContextId& ContextId) const
+{
+	FContextPartition* Partition = GetPartition(GetPartitionIndex(ContextId));
+	return Partition ? &Partition->Shards[GetShardIndex(ContextId)] : nullptr;
+}
+
+int32 FEnhancedAsyncContextManager::FindPartition(const UWorld* World) const
+{
+	if (World == nullptr)
+	{
+		return GlobalPartition;
+	}
+
+	FReadScopeLock Lock(PartitionLock);
+	const uint32* PartitionIndex = WorldToPartition.Find(World);
+	return PartitionIndex ? static_cast<int32>(*PartitionIndex) : INDEX_NONE;
+}
+
+uint32 FEnhancedAsyncContextManager::FindOrAddPartition(const UWorld* World)
+{
+	const int32 ExistingIndex = FindPartition(World);
+	if (ExistingIndex != INDEX_NONE)
+	{
+		return static_cast<uint32>(ExistingIndex);
+	}
+
+	FWriteScopeLock Lock(PartitionLock);
+	if (const uint32* PartitionIndex = WorldToPartition.Find(World))
+	{ // lost the race with another writer
+		return *PartitionIndex;
+	}
+
+	uint32 PartitionIndex;
+	if (!FreePartitions.IsEmpty())
+	{
+		PartitionIndex = FreePartitions.Pop(EAllowShrinking::No);
+	}
+	else if (NumAllocatedPartitions < MaxPartitions)
+	{
+		PartitionIndex = NumAllocatedPartitions++;
+		Partitions[PartitionIndex].store(new FContextPartition(), std::memory_order_release);
+	}
+	else
+	{
+		UE_LOG(LogEnhancedAction, Warning, TEXT("Context partition limit reached, contexts of %s are kept in global partition"), *GetNameSafe(World));
+		return GlobalPartition;
+	}
+
+	GetPartition(PartitionIndex)->World = World;
+	WorldToPartition.Add(World, PartitionIndex);
+	return PartitionIndex;
+}
+
+FAsyncContextId FEnhancedAsyncContextManager::MakeId(uint32 PartitionIndex, uint32 ShardIndex, uint32 LocalIndex, const FContextSlot& Slot)
+{
+	const uint32 Index = (LocalIndex << (ShardBits + PartitionBits)) | (PartitionIndex << ShardBits) | ShardIndex;
+#if WITH_CONTEXT_TYPE_TAG
+	// latent calls always have non-zero UUID
+	const auto Type = Slot.Key.UUID != 0 ? FAsyncContextId::CT_LatentAction : FAsyncContextId::CT_AsyncAction;
+	return FAsyncContextId(Index, Slot.Generation, Type);
+#else
+	return FAsyncContextId(Index, Slot.Generation);
+#endif
+}
+
+FEnhancedAsyncContextManager::FContextSlot* FEnhancedAsyncContextManager::FindSlot(FContextShard& Shard, const FAsyncContextId& ContextId)
+{
+	const int32 LocalIndex = static_cast<int32>(GetLocalIndex(ContextId));
+	if (!Shard.Slots.IsValidIndex(LocalIndex))
+	{
+		return nullptr;
+	}
+
+	FContextSlot& Slot = Shard.Slots[LocalIndex];
+	if (!Slot.Context.IsValid() || Slot.Generation != ContextId.GetGeneration())
+	{ // released or reused
+		return nullptr;
+	}
+	return &Slot;
+}
+
+void FEnhancedAsyncContextManager::AddReferenceSlot(FContextShard& Shard, uint32 LocalIndex)
+{
+	FContextSlot& Slot = Shard.Slots[LocalIndex];
+	if (Slot.ReferenceIndex == INDEX_NONE)
+	{
+		Slot.ReferenceIndex = Shard.ReferenceSlots.Add(LocalIndex);
+	}
+}
+
+void FEnhancedAsyncContextManager::RemoveReferenceSlot(FContextShard& Shard, uint32 LocalIndex)
+{
+	FContextSlot& Slot = Shard.Slots[LocalIndex];
+	if (Slot.ReferenceIndex != INDEX_NONE)
+	{
+		const int32 Position = Slot.ReferenceIndex;
+		Shard.ReferenceSlots.RemoveAtSwap(Position, EAllowShrinking::No);
+		if (Shard.ReferenceSlots.IsValidIndex(Position))
+		{ // fix position of the slot moved into the hole
+			Shard.Slots[Shard.ReferenceSlots[Position]].ReferenceIndex = Position;
+		}
+		Slot.ReferenceIndex = INDEX_NONE;
+	}
+}
+
+void FEnhancedAsyncContextManager::LinkOwnerSlot(FContextShard& Shard, uint32 LocalIndex)
+{
+	FContextSlot& Slot = Shard.Slots[LocalIndex];
+	int32& Head = Shard.OwnerHeads.FindOrAdd(Slot.Key.Owner, INDEX_NONE);
+	if (Head != INDEX_NONE)
+	{
+		Shard.Slots[Head].OwnerPrev = LocalIndex;
+	}
+	Slot.OwnerPrev = INDEX_NONE;
+	Slot.OwnerNext = Head;
+	Head = LocalIndex;
+}
+
+void FEnhancedAsyncContextManager::UnlinkOwnerSlot(FContextShard& Shard, uint32 LocalIndex)
+{
+	FContextSlot& Slot = Shard.Slots[LocalIndex];
+	if (Slot.OwnerNext != INDEX_NONE)
+	{
+		Shard.Slots[Slot.OwnerNext].OwnerPrev = Slot.OwnerPrev;
+	}
+
+	if (Slot.OwnerPrev != INDEX_NONE)
+	{
+		Shard.Slots[Slot.OwnerPrev].OwnerNext = Slot.OwnerNext;
+	}
+	else if (Slot.OwnerNext != INDEX_NONE)
+	{ // head moves to the next slot
+		Shard.OwnerHeads.FindChecked(Slot.Key.Owner) = Slot.OwnerNext;
+	}
+	else
+	{ // last context of the owner
+		Shard.OwnerHeads.Remove(Slot.Key.Owner);
+	}
+
+	Slot.OwnerPrev = INDEX_NONE;
+	Slot.OwnerNext = INDEX_NONE;
+}
+
+TSharedPtr<FEnhancedAsyncActionContext> FEnhancedAsyncContextManager::ReleaseSlot(FContextShard& Shard, uint32 LocalIndex)
+{
+	RemoveReferenceSlot(Shard, LocalIndex);
+
+	FContextSlot& Slot = Shard.Slots[LocalIndex];
+
+	TSharedPtr<FEnhancedAsyncActionContext> Context = MoveTemp(Slot.Context);
+	Context->RegisteredId.store(FAsyncContextId(), std::memory_order_release);
+	Shard.KeyToSlot.Remove(Slot.Key);
+	Slot.Key = FContextKey();
+	Slot.OwnerIndex = INDEX_NONE;
+	if (Slot.TimeToLive > 0.f)
+	{
+		NumExpiringContexts.fetch_sub(1, std::memory_order_relaxed);
+		Slot.TimeToLive = 0.f;
+	}
+
+	// generation shares identifier serial with type tag, keep it within range and never zero
+#if WITH_CONTEXT_TYPE_TAG
+	constexpr uint32 GenerationMask = MAX_uint32 >> FAsyncContextId::CT_SHIFT;
+#else
+	constexpr uint32 GenerationMask = MAX_uint32;
+#endif
+	Slot.Generation = FMath::Max((Slot.Generation + 1) & GenerationMask, 1u);
+
+	Shard.FreeSlots.Add(LocalIndex);
+	return Context;
+}
+
 TValueOrError<FEnhancedAsyncActionContextHandle, FString> FEnhancedAsyncContextManager::CreateContext(const UObject* Action, FName InnerProperty)
 {
-	FScopeLock Lock(&MapCriticalSection);
+	TSharedPtr<FEnhancedAsyncActionContext> Context;
+	return CreateContext(Action, InnerProperty, Context);
+}
 
+TValueOrError<FEnhancedAsyncActionContextHandle, FString> FEnhancedAsyncContextManager::CreateContext(const UObject* Action, FName InnerProperty, TSharedPtr<FEnhancedAsyncActionContext>& OutContext)
+{
 	if (!IsValid(Action))
 	{
 		return MakeError(TEXT("Invalid action object"));
 	}
 
-	const FAsyncContextId Id = FAsyncContextId::Make(Action);
+	if (HasPendingTeardown())
+	{ // address may belong to an owner deleted since last flush
+		FlushPendingTeardown();
+	}
+
+	const FContextKey Key { Action };
+	const uint32 PartitionIndex = FindOrAddPartition(GetOwnerWorld(Action));
 
-	if (auto ExistingHandle = ActionContexts.FindRef(Id))
 	{
-		return MakeError(TEXT("Object already has bound context"));
+		FContextShard& Shard = GetPartition(PartitionIndex)->Shards[GetOwnerShardIndex(Action)];
+		FReadScopeLock Lock(Shard.Lock);
+		if (Shard.KeyToSlot.Contains(Key))
+		{
+			return MakeError(TEXT("Object already has bound context"));
+		}
 	}
 
 	TSharedPtr<FEnhancedAsyncActionContext> Context;
@@ -59,7 +281,7 @@ TValueOrError<FEnhancedAsyncActionContextHandle, FString> FEnhancedAsyncContextM
 			InDataProperty = NAME_None;
 		}
 
-		Context = MakeShared<FEnhancedAsyncActionContext_PropertyBag>(Action);
+		Context = ContextPool.AcquireContext(Action);
 	}
 
 	if (!Context.IsValid())
@@ -67,119 +289,343 @@ TValueOrError<FEnhancedAsyncActionContextHandle, FString> FEnhancedAsyncContextM
 		return MakeError(TEXT("Failed to select context backend implementation"));
 	}
 
-	SetContextInternal(Id, Context.ToSharedRef(), Action);
+	const float TimeToLive = UEnhancedAsyncContextSettings::Get()->GetContextTimeToLive(Action->GetClass());
+
+	const FAsyncContextId Id = SetContextInternal(PartitionIndex, Key, Context.ToSharedRef(), TimeToLive);
+	if (!Id.IsValid())
+	{
+		return MakeError(TEXT("Object already has bound context"));
+	}
 
-	const FEnhancedAsyncActionContextHandle Result(Id, Action, Context.ToSharedRef());
+	const FEnhancedAsyncActionContextHandle Result(Id, Action);
 
+	OutContext = MoveTemp(Context);
 	return MakeValue(Result);
 }
 
 TValueOrError<FEnhancedLatentActionContextHandle, FString> FEnhancedAsyncContextManager::CreateContext(const FLatentCallInfo& CallInfo)
 {
-	FScopeLock Lock(&MapCriticalSection);
-
 	if (!CallInfo.IsValid())
 	{
 		return MakeError(TEXT("Invalid latent info"));
 	}
 
-	const FAsyncContextId Id = FAsyncContextId::Make(CallInfo);
+	if (HasPendingTeardown())
+	{ // address may belong to an owner deleted since last flush
+		FlushPendingTeardown();
+	}
+
+	const FContextKey Key { CallInfo.OwningObject.Get(), CallInfo.UUID, CallInfo.CallID };
 
-	if (TSharedPtr<FEnhancedAsyncActionContext> ExistingHandle = ActionContexts.FindRef(Id))
+	const uint32 PartitionIndex = FindOrAddPartition(GetOwnerWorld(Key.Owner));
+
+	auto Context = ContextPool.AcquireContext(CallInfo.OwningObject.Get());
+
+	const FAsyncContextId Id = SetContextInternal(PartitionIndex, Key, Context);
+	if (!Id.IsValid())
 	{
 		return MakeError(TEXT("Invalid action identifier"));
 	}
 
-	auto Context = MakeShared<FEnhancedAsyncActionContext_PropertyBag>(CallInfo.OwningObject.Get());
+	const FEnhancedLatentActionContextHandle Result(Id, CallInfo);
+
+	return MakeValue(Result);
+}
 
-	SetContextInternal(Id, Context, CallInfo.OwningObject.Get());
+bool FEnhancedAsyncContextManager::ReplaceContext(const FAsyncContextId& ContextId, TSharedRef<FEnhancedAsyncActionContext> Context)
+{
+	TSharedPtr<FEnhancedAsyncActionContext> Previous;
 
-	const FEnhancedLatentActionContextHandle Result(Id, CallInfo, Context);
+	if (FContextShard* Shard = FindShard(ContextId))
+	{
+		FWriteScopeLock Lock(Shard->Lock);
 
-	return MakeValue(Result);
+		FContextSlot* Slot = FindSlot(*Shard, ContextId);
+		if (Slot && Slot->ReferenceIndex == INDEX_NONE)
+		{
+			Previous = MoveTemp(Slot->Context);
+			// entries resolved without pinning must not match previous context
+			Previous->RegisteredId.store(FAsyncContextId(), std::memory_order_release);
+
+			Slot->Context = Context;
+			Context->RegisteredId.store(ContextId, std::memory_order_release);
+			if (Context->CanAddReferencedObjects() && Context->HasObjectReferences())
+			{
+				AddReferenceSlot(*Shard, GetLocalIndex(ContextId));
+			}
+		}
+	}
+
+	if (!Previous.IsValid())
+	{
+		return false;
+	}
+
+	RecycleContext(ContextId, MoveTemp(Previous));
+	return true;
 }
 
 TValueOrError<int32, FString> FEnhancedAsyncContextManager::DestroyContext(const FAsyncContextId& ContextId)
 {
-	FScopeLock Lock(&MapCriticalSection);
+	if (!ContextId.IsValid())
+	{
+		return MakeValue(0);
+	}
+
+	// released outside of the shard lock
+	TSharedPtr<FEnhancedAsyncActionContext> ContextObject;
 
-	if (TSharedPtr<FEnhancedAsyncActionContext> ContextObject = ActionContexts.FindRef(ContextId))
+	if (FContextShard* Shard = FindShard(ContextId))
 	{
-		int32 Removed = ActionContexts.Remove(ContextId);
+		FWriteScopeLock Lock(Shard->Lock);
 
-		if (const UObject* Owner = ContextObject->GetOwningObject())
+		if (FContextSlot* Slot = FindSlot(*Shard, ContextId))
 		{
-			TrackedObjects.RemoveSingle(Owner, ContextId);
+			const uint32 LocalIndex = GetLocalIndex(ContextId);
+			UnlinkOwnerSlot(*Shard, LocalIndex);
+			if (!Shard->OwnerHeads.Contains(Slot->Key.Owner))
+			{
+				TrackedFilter.Remove(Slot->OwnerIndex);
+			}
+			ContextObject = ReleaseSlot(*Shard, LocalIndex);
 		}
+	}
 
-		return MakeValue(Removed);
+	if (!ContextObject.IsValid())
+	{
+		return MakeValue(0);
 	}
 
+	NumContexts.fetch_sub(1);
 	ObjectListener.UpdateState();
-	return MakeValue(0);
+
+	RecycleContext(ContextId, MoveTemp(ContextObject));
+
+	return MakeValue(1);
 }
 
 TValueOrError<int32, FString> FEnhancedAsyncContextManager::DestroyContext(const FEnhancedLatentActionContextHandle& Handle)
 {
-	FScopeLock Lock(&MapCriticalSection);
+	return DestroyContext(Handle.GetId());
+}
+
+void FEnhancedAsyncContextManager::RecycleContext(const FAsyncContextId& ContextId, TSharedPtr<FEnhancedAsyncActionContext>&& Context)
+{
+	if (!IsInGameThread())
+	{ // game thread may be using the context resolved without pinning
+		FScopeLock Lock(&PendingCriticalSection);
+		DeferredReleases.Add({ ContextId, MoveTemp(Context) });
+		NumDeferredReleases.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
 
-	auto Value = DestroyContext(Handle.GetId());
+	EvictResolvedContext(ContextId);
 
-	if (const UObject* Owner = Handle.Owner.GetEvenIfUnreachable())
+	// context may still be held by a caller that resolved it before release
+	if (Context.IsValid() && Context->CanRecycle() && Context.IsUnique() && FEnhancedAsyncContextPool::IsEnabled())
 	{
-		TrackedObjects.RemoveSingle(Owner, Handle.GetId());
+		ContextPool.ReleaseContext(StaticCastSharedPtr<FEnhancedAsyncActionContext_PropertyBag>(MoveTemp(Context)));
 	}
-
-	return Value;
+	Context.Reset();
 }
 
-void FEnhancedAsyncContextManager::SetContextInternal(FAsyncContextId ContextId, TSharedRef<FEnhancedAsyncActionContext> Context, const UObject* TrackedOwner)
+FAsyncContextId FEnhancedAsyncContextManager::SetContextInternal(uint32 PartitionIndex, const FContextKey& Key, TSharedRef<FEnhancedAsyncActionContext> Context, float TimeToLive)
 {
-	FScopeLock Lock(&MapCriticalSection);
+	check(Key.Owner != nullptr);
 
-	if (!ObjectCollector.IsValid() && Context->CanAddReferencedObjects())
-	{ // create collector lazily
-		ObjectCollector = MakeShared<FGCCollector>(this);
+	if (Context->CanAddReferencedObjects())
+	{
+		FScopeLock Lock(&StateCriticalSection);
+		if (!ObjectCollector.IsValid())
+		{ // create collector lazily
+			ObjectCollector = MakeShared<FGCCollector>(this);
+		}
+	}
+
+	if (!TrackedFilter.IsInitialized())
+	{
+		FScopeLock Lock(&StateCriticalSection);
+		TrackedFilter.Initialize();
 	}
 
-	bool bDuplicate = ActionContexts.Contains(ContextId);
-	checkf(!bDuplicate, TEXT("CRITICAL: For some unknown reason there is a context with same identifier???"));
-	if (!bDuplicate)
+	FAsyncContextId Id;
+
 	{
-		ActionContexts.Add(ContextId, Context);
-		if (TrackedOwner)
+		const uint32 ShardIndex = GetOwnerShardIndex(Key.Owner);
+		FContextShard& Shard = GetPartition(PartitionIndex)->Shards[ShardIndex];
+		FWriteScopeLock Lock(Shard.Lock);
+
+		if (Shard.KeyToSlot.Contains(Key))
+		{ // lost the race with another writer
+			return FAsyncContextId();
+		}
+
+		uint32 LocalIndex;
+		if (!Shard.FreeSlots.IsEmpty())
+		{
+			LocalIndex = Shard.FreeSlots.Pop(EAllowShrinking::No);
+		}
+		else
+		{
+			LocalIndex = Shard.Slots.AddDefaulted();
+			checkf(LocalIndex < (MAX_uint32 >> (ShardBits + PartitionBits)), TEXT("Context slot storage exhausted"));
+		}
+
+		FContextSlot& Slot = Shard.Slots[LocalIndex];
+		Slot.Context = Context;
+		Slot.Key = Key;
+		Slot.OwnerIndex = GUObjectArray.ObjectToIndex(Key.Owner);
+		Slot.CreationTime = FPlatformTime::Seconds();
+		if (TimeToLive > 0.f)
+		{
+			Slot.TimeToLive = TimeToLive;
+			NumExpiringContexts.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		Id = MakeId(PartitionIndex, ShardIndex, LocalIndex, Slot);
+		Context->RegisteredId.store(Id, std::memory_order_release);
+		if (Context->CanAddReferencedObjects() && Context->HasObjectReferences())
 		{
-			TrackedObjects.AddUnique(TrackedOwner, ContextId);
+			AddReferenceSlot(Shard, LocalIndex);
 		}
+
+		Shard.KeyToSlot.Add(Key, LocalIndex);
+		LinkOwnerSlot(Shard, LocalIndex);
+		TrackedFilter.Add(Slot.OwnerIndex, PartitionIndex);
 	}
 
+	NumContexts.fetch_add(1);
 	ObjectListener.UpdateState();
+	return Id;
 }
 
 FEnhancedAsyncActionContextHandle FEnhancedAsyncContextManager::FindContextHandle(const UObject* Action)
 {
-	FScopeLock Lock(&MapCriticalSection);
+	if (HasPendingTeardown())
+	{
+		FlushPendingTeardown();
+	}
+
+	const FContextKey Key { Action };
+
+	const int32 PartitionIndex = Action ? FindPartition(GetOwnerWorld(Action)) : INDEX_NONE;
+	if (PartitionIndex == INDEX_NONE)
+	{
+		return FEnhancedAsyncActionContextHandle();
+	}
+
+	const uint32 ShardIndex = GetOwnerShardIndex(Action);
+	FContextShard& Shard = GetPartition(PartitionIndex)->Shards[ShardIndex];
+	FReadScopeLock Lock(Shard.Lock);
 
-	const FAsyncContextId Id = FAsyncContextId::Make(Action);
-	if (TSharedPtr<FEnhancedAsyncActionContext> ContextObject = ActionContexts.FindRef(Id))
+	if (const uint32* LocalIndex = Shard.KeyToSlot.Find(Key))
 	{
-		return FEnhancedAsyncActionContextHandle( Id, Action, ContextObject.ToSharedRef() );
+		const FAsyncContextId Id = MakeId(PartitionIndex, ShardIndex, *LocalIndex, Shard.Slots[*LocalIndex]);
+		return FEnhancedAsyncActionContextHandle( Id, Action );
 	}
 	return FEnhancedAsyncActionContextHandle();
 }
 
+TSharedPtr<FEnhancedAsyncActionContext> FEnhancedAsyncContextManager::FindContext(const UObject* Action, FAsyncContextId& OutContextId)
+{
+	if (HasPendingTeardown())
+	{
+		FlushPendingTeardown();
+	}
+
+	const FContextKey Key { Action };
+
+	const int32 PartitionIndex = Action ? FindPartition(GetOwnerWorld(Action)) : INDEX_NONE;
+	if (PartitionIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	const uint32 ShardIndex = GetOwnerShardIndex(Action);
+	FContextShard& Shard = GetPartition(PartitionIndex)->Shards[ShardIndex];
+	FReadScopeLock Lock(Shard.Lock);
+
+	const uint32* LocalIndex = Shard.KeyToSlot.Find(Key);
+	if (!LocalIndex)
+	{
+		return nullptr;
+	}
+
+	const FContextSlot& Slot = Shard.Slots[*LocalIndex];
+	if (!Slot.Context.IsValid() || !Slot.Context->IsValid())
+	{
+		return nullptr;
+	}
+
+	OutContextId = MakeId(PartitionIndex, ShardIndex, *LocalIndex, Slot);
+	return Slot.Context;
+}
+
 FEnhancedLatentActionContextHandle FEnhancedAsyncContextManager::FindContextHandle(const FLatentCallInfo& CallInfo)
 {
-	FScopeLock Lock(&MapCriticalSection);
+	if (HasPendingTeardown())
+	{
+		FlushPendingTeardown();
+	}
 
-	const FAsyncContextId Id = FAsyncContextId::Make(CallInfo);
-	if (TSharedPtr<FEnhancedAsyncActionContext> ContextObject = ActionContexts.FindRef(Id))
+	const FContextKey Key { CallInfo.OwningObject.Get(), CallInfo.UUID, CallInfo.CallID };
+
+	const int32 PartitionIndex = Key.Owner ? FindPartition(GetOwnerWorld(Key.Owner)) : INDEX_NONE;
+	if (PartitionIndex == INDEX_NONE)
+	{
+		return FEnhancedLatentActionContextHandle();
+	}
+
+	const uint32 ShardIndex = GetOwnerShardIndex(Key.Owner);
+	FContextShard& Shard = GetPartition(PartitionIndex)->Shards[ShardIndex];
+	FReadScopeLock Lock(Shard.Lock);
+
+	if (const uint32* LocalIndex = Shard.KeyToSlot.Find(Key))
 	{
-		return FEnhancedLatentActionContextHandle( Id, CallInfo, ContextObject.ToSharedRef()  );
+		const FAsyncContextId Id = MakeId(PartitionIndex, ShardIndex, *LocalIndex, Shard.Slots[*LocalIndex]);
+		return FEnhancedLatentActionContextHandle( Id, CallInfo );
 	}
 	return FEnhancedLatentActionContextHandle();
 }
 
+FEnhancedAsyncContextArena* FEnhancedAsyncContextManager::FindContextArena(const FAsyncContextId& ContextId, const UObject* Owner) const
+{
+	if (Owner == nullptr || !FEnhancedAsyncContextArena::IsEnabledForClass(Owner->GetClass()))
+	{
+		return nullptr;
+	}
+
+	FContextPartition* Partition = GetPartition(GetPartitionIndex(ContextId));
+	return Partition ? &Partition->Arena : nullptr;
+}
+
+FEnhancedAsyncContextArena::FStats FEnhancedAsyncContextManager::GetArenaStats() const
+{
+	FEnhancedAsyncContextArena::FStats Stats;
+	for (uint32 PartitionIndex = 0; PartitionIndex < MaxPartitions; ++PartitionIndex)
+	{
+		if (const FContextPartition* Partition = GetPartition(PartitionIndex))
+		{
+			Stats += Partition->Arena.GetStats();
+		}
+	}
+	return Stats;
+}
+
+void FEnhancedAsyncContextManager::NotifyContextReferencesAdded(const FAsyncContextId& ContextId)
+{
+	if (FContextShard* Shard = FindShard(ContextId))
+	{
+		FWriteScopeLock Lock(Shard->Lock);
+
+		const FContextSlot* Slot = FindSlot(*Shard, ContextId);
+		if (Slot && Slot->Context->CanAddReferencedObjects())
+		{
+			AddReferenceSlot(*Shard, GetLocalIndex(ContextId));
+		}
+	}
+}
+
 TSharedPtr<FEnhancedAsyncActionContext> FEnhancedAsyncContextManager::HandleError(EResolveErrorMode OnError, const TCHAR* Message) const
 {
 	switch (OnError)
@@ -204,7 +650,25 @@ TSharedPtr<FEnhancedAsyncActionContext> FEnhancedAsyncContextManager::FindContex
 		return HandleError(OnError, TEXT("Failed to locate bound context object"));
 	}
 
-	auto ActualContext = Handle.Data.Pin();
+	return FindContext(Handle.GetId(), OnError);
+}
+
+TSharedPtr<FEnhancedAsyncActionContext> FEnhancedAsyncContextManager::FindContext(const FAsyncContextId& ContextId, EResolveErrorMode OnError)
+{
+	if (!ContextId)
+	{
+		return HandleError(OnError, TEXT("Failed to locate bound context object"));
+	}
+
+	TSharedPtr<FEnhancedAsyncActionContext> ActualContext;
+	if (FContextShard* Shard = FindShard(ContextId))
+	{
+		FReadScopeLock Lock(Shard->Lock);
+		if (const FContextSlot* Slot = FindSlot(*Shard, ContextId))
+		{
+			ActualContext = Slot->Context;
+		}
+	}
 
 	if (!ActualContext)
 	{
@@ -218,28 +682,101 @@ TSharedPtr<FEnhancedAsyncActionContext> FEnhancedAsyncContextManager::FindContex
 	return ActualContext;
 }
 
-TSharedPtr<FEnhancedAsyncActionContext> FEnhancedAsyncContextManager::FindContext(const FAsyncContextId& ContextId, EResolveErrorMode OnError)
+FEnhancedAsyncActionContext* FEnhancedAsyncContextManager::FindContextOnGameThread(const FAsyncContextId& ContextId, EResolveErrorMode OnError)
 {
-	if (!ContextId)
+	check(IsInGameThread());
+
+	FResolvedContext& Entry = ResolveCache[GetResolveCacheIndex(ContextId)];
+	// registered identifier is reset on release, context destroyed off game thread is rejected before it is evicted
+	if (ContextId.IsValid() && Entry.Id == ContextId && Entry.Context->RegisteredId.load(std::memory_order_acquire) == ContextId)
 	{
-		return HandleError(OnError, TEXT("Failed to locate bound context object"));
+		// owner may have died after context was cached
+		if (!Entry.Context->IsValid())
+		{
+			return HandleError(OnError, TEXT("Bound context object is stale")).Get();
+		}
+		return Entry.Context;
+	}
+
+	TSharedPtr<FEnhancedAsyncActionContext> Context = FindContext(ContextId, EResolveErrorMode::AllowNull);
+	if (!Context.IsValid())
+	{
+		return HandleError(OnError, TEXT("Failed to locate bound context object")).Get();
 	}
 
-	FScopeLock Lock(&MapCriticalSection);
+	// registry keeps the context alive until entry is evicted
+	Entry.Id = ContextId;
+	Entry.Context = Context.Get();
+	return Entry.Context;
+}
 
-	// auto ActualContext = Handle.Data.Pin();
-	auto ActualContext = ActionContexts.FindRef(ContextId);
+FEnhancedAsyncActionContext* FEnhancedAsyncContextManager::FindContextOnGameThread(const UObject* Action, FAsyncContextId& OutContextId)
+{
+	check(IsInGameThread());
 
-	if (!ActualContext)
+	if (HasPendingTeardown())
 	{
-		return HandleError(OnError, TEXT("Failed to locate bound context object"));
+		FlushPendingTeardown();
 	}
 
-	if (!ActualContext->IsValid())
+	FResolvedOwner& Entry = ResolveOwnerCache[GetResolveCacheIndex(Action)];
+	if (Action != nullptr && Entry.Owner == Action)
 	{
-		return HandleError(OnError, TEXT("Bound context object is stale"));
+		// released identifier misses, object allocated at address of dead owner fails owner check
+		FEnhancedAsyncActionContext* Context = FindContextOnGameThread(Entry.Id, EResolveErrorMode::AllowNull);
+		if (Context && Context->GetOwningObject() == Action)
+		{
+			OutContextId = Entry.Id;
+			return Context;
+		}
+	}
+
+	FAsyncContextId ContextId;
+	TSharedPtr<FEnhancedAsyncActionContext> Context = FindContext(Action, ContextId);
+	if (!Context.IsValid())
+	{
+		Entry = FResolvedOwner();
+		return nullptr;
+	}
+
+	// registry keeps the context alive until identifier entry is evicted
+	Entry.Owner = Action;
+	Entry.Id = ContextId;
+	FResolvedContext& ResolvedEntry = ResolveCache[GetResolveCacheIndex(ContextId)];
+	ResolvedEntry.Id = ContextId;
+	ResolvedEntry.Context = Context.Get();
+
+	OutContextId = ContextId;
+	return ResolvedEntry.Context;
+}
+
+void FEnhancedAsyncContextManager::EvictResolvedContext(const FAsyncContextId& ContextId)
+{
+	FResolvedContext& Entry = ResolveCache[GetResolveCacheIndex(ContextId)];
+	if (Entry.Id == ContextId)
+	{
+		Entry = FResolvedContext();
+	}
+}
+
+void FEnhancedAsyncContextManager::FlushDeferredReleases()
+{
+	if (!HasDeferredReleases())
+	{
+		return;
+	}
+
+	TArray<FReleasedContext> Released;
+	{
+		FScopeLock Lock(&PendingCriticalSection);
+		Released = MoveTemp(DeferredReleases);
+		NumDeferredReleases.store(0, std::memory_order_relaxed);
+	}
+
+	for (FReleasedContext& Entry : Released)
+	{
+		RecycleContext(Entry.Id, MoveTemp(Entry.Context));
 	}
-	return ActualContext;
 }
 
 void FEnhancedAsyncContextManager::FGCCollector::AddReferencedObjects(FReferenceCollector& Collector)
@@ -249,43 +786,302 @@ void FEnhancedAsyncContextManager::FGCCollector::AddReferencedObjects(FReference
 
 void FEnhancedAsyncContextManager::AddReferencedObjects(FReferenceCollector& Collector)
 {
-	FScopeLock Lock(&MapCriticalSection);
-	for (auto It = ActionContexts.CreateIterator(); It; ++It)
+	for (uint32 PartitionIndex = 0; PartitionIndex < MaxPartitions; ++PartitionIndex)
 	{
-		if (It->Value->CanAddReferencedObjects() && It->Value->IsValid())
+		FContextPartition* Partition = GetPartition(PartitionIndex);
+		if (Partition == nullptr)
+		{
+			continue;
+		}
+
+		for (FContextShard& Shard : Partition->Shards)
 		{
-			It->Value->AddReferencedObjects(Collector);
+			FReadScopeLock Lock(Shard.Lock);
+			if (GSkipContextsWithoutReferences)
+			{
+				// bag structs of skipped contexts are kept alive by the layout cache
+				for (uint32 LocalIndex : Shard.ReferenceSlots)
+				{
+					const FContextSlot& Slot = Shard.Slots[LocalIndex];
+					if (Slot.Context->IsValid())
+					{
+						Slot.Context->AddReferencedObjects(Collector);
+					}
+				}
+				continue;
+			}
+
+			for (const FContextSlot& Slot : Shard.Slots)
+			{
+				if (Slot.Context.IsValid() && Slot.Context->CanAddReferencedObjects() && Slot.Context->IsValid())
+				{
+					Slot.Context->AddReferencedObjects(Collector);
+				}
+			}
 		}
 	}
+
+	ContextPool.AddReferencedObjects(Collector);
 }
 
 void FEnhancedAsyncContextManager::FObjectListener::NotifyUObjectDeleted(const UObjectBase* Object, int32 Index)
 {
-	Owner->OnObjectDeleted(static_cast<const UObject*>(Object));
+	if (Owner->TrackedFilter.Contains(Index))
+	{
+		const uint32 PartitionIndex = Owner->TrackedFilter.GetPartition(Index);
+		Owner->TrackedFilter.Remove(Index);
+		Owner->OnObjectDeleted(static_cast<const UObject*>(Object), PartitionIndex);
+	}
 }
 
-void FEnhancedAsyncContextManager::OnObjectDeleted(const UObject* Object)
+void FEnhancedAsyncContextManager::OnObjectDeleted(const UObject* Object, uint32 PartitionIndex)
 {
-	FScopeLock Lock(&MapCriticalSection);
+	// called from within purge, only record the owner and leave registry work to the batch
+	FScopeLock Lock(&PendingCriticalSection);
+	if (PartitionIndex < MaxPartitions)
+	{
+		PendingOwners[PartitionIndex].Add(Object);
+		PendingPartitions |= 1ull << PartitionIndex;
+	}
+	else
+	{
+		PendingOwnersAnyPartition.Add(Object);
+	}
+	NumPendingOwners.fetch_add(1, std::memory_order_relaxed);
+}
 
-	const FAsyncContextId Id = FAsyncContextId::Make(Object);
-	if (ActionContexts.Remove(Id) > 0)
-	{ // this was an async action object. it will have just one entry as it can't have latents within
-		TrackedObjects.Remove(Object);
+void FEnhancedAsyncContextManager::FlushPendingTeardown()
+{
+	if (!HasPendingTeardown())
+	{
+		return;
 	}
-	else if (TrackedObjects.Contains(Object))
-	{ // this will be latent action owner. once it is gone - all latents should be gone
-		TArray<FAsyncContextId, TFixedAllocator<32>> BoundContextIds;
-		TrackedObjects.MultiFind(Object, BoundContextIds);
-		TrackedObjects.Remove(Object);
 
-		for (const FAsyncContextId& ContextId : BoundContextIds)
+	TStaticArray<TArray<const UObject*>, MaxPartitions> OwnersByPartition;
+	uint64 PartitionMask = 0;
+	int32 NumOwners = 0;
+	{
+		FScopeLock Lock(&PendingCriticalSection);
+		for (uint64 Mask = PendingPartitions; Mask; Mask &= Mask - 1)
 		{
-			ActionContexts.Remove(ContextId);
+			const uint32 PartitionIndex = FMath::CountTrailingZeros64(Mask);
+			OwnersByPartition[PartitionIndex] = MoveTemp(PendingOwners[PartitionIndex]);
 		}
+		PartitionMask = PendingPartitions;
+		PendingPartitions = 0;
+
+		if (!PendingOwnersAnyPartition.IsEmpty())
+		{ // partition of these owners is unknown, they are looked up in every allocated partition
+			for (uint32 PartitionIndex = 0; PartitionIndex < MaxPartitions; ++PartitionIndex)
+			{
+				if (GetPartition(PartitionIndex) != nullptr)
+				{
+					OwnersByPartition[PartitionIndex].Append(PendingOwnersAnyPartition);
+					PartitionMask |= 1ull << PartitionIndex;
+				}
+			}
+			PendingOwnersAnyPartition.Reset();
+		}
+		NumOwners = NumPendingOwners.exchange(0, std::memory_order_relaxed);
 	}
 
-	ObjectListener.UpdateState();
+	// payloads are destroyed after all locks are released
+	TArray<FReleasedContext> RemovedContexts;
+
+	// only partitions that had owners deleted are visited
+	for (uint64 Mask = PartitionMask; Mask; Mask &= Mask - 1)
+	{
+		const uint32 PartitionIndex = FMath::CountTrailingZeros64(Mask);
+		FContextPartition* Partition = GetPartition(PartitionIndex);
+		if (Partition == nullptr)
+		{
+			continue;
+		}
+
+		TArray<const UObject*>& Owners = OwnersByPartition[PartitionIndex];
+
+		// group owners by shard so each shard is locked once
+		Owners.Sort([](const UObject& A, const UObject& B)
+		{
+			return GetOwnerShardIndex(&A) < GetOwnerShardIndex(&B);
+		});
+
+		for (int32 Start = 0; Start < Owners.Num();)
+		{
+			const uint32 ShardIndex = GetOwnerShardIndex(Owners[Start]);
+			FContextShard& Shard = Partition->Shards[ShardIndex];
+
+			FWriteScopeLock Lock(Shard.Lock);
+
+			for (; Start < Owners.Num() && GetOwnerShardIndex(Owners[Start]) == ShardIndex; ++Start)
+			{
+				int32 LocalIndex;
+				if (!Shard.OwnerHeads.RemoveAndCopyValue(Owners[Start], LocalIndex))
+				{
+					continue;
+				}
+
+				// whole list goes away, slots are detached without relinking neighbours
+				while (LocalIndex != INDEX_NONE)
+				{
+					FContextSlot& Slot = Shard.Slots[LocalIndex];
+					const int32 NextIndex = Slot.OwnerNext;
+					Slot.OwnerPrev = INDEX_NONE;
+					Slot.OwnerNext = INDEX_NONE;
+
+					const FAsyncContextId Id = MakeId(PartitionIndex, ShardIndex, LocalIndex, Slot);
+					RemovedContexts.Add({ Id, ReleaseSlot(Shard, LocalIndex) });
+					LocalIndex = NextIndex;
+				}
+			}
+		}
+	}
+
+	if (RemovedContexts.Num())
+	{
+		NumContexts.fetch_sub(RemovedContexts.Num());
+		ObjectListener.UpdateState();
+	}
+
+	UE_LOG(LogEnhancedAction, Verbose, TEXT("Released %d contexts of %d deleted owners"), RemovedContexts.Num(), NumOwners);
+
+	for (FReleasedContext& Entry : RemovedContexts)
+	{
+		RecycleContext(Entry.Id, MoveTemp(Entry.Context));
+	}
+}
+
+void FEnhancedAsyncContextManager::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	if (!bCleanupResources)
+	{ // world is kept for reuse along with its objects
+		return;
+	}
+
+	uint32 PartitionIndex;
+	{
+		FWriteScopeLock Lock(PartitionLock);
+		if (!WorldToPartition.RemoveAndCopyValue(World, PartitionIndex))
+		{ // world never had contexts
+			return;
+		}
+	}
+
+	FContextPartition* Partition = GetPartition(PartitionIndex);
+
+	// payloads are destroyed after all locks are released
+	TArray<FReleasedContext> RemovedContexts;
+
+	for (uint32 ShardIndex = 0; ShardIndex < NumShards; ++ShardIndex)
+	{
+		FContextShard& Shard = Partition->Shards[ShardIndex];
+		FWriteScopeLock Lock(Shard.Lock);
+
+		TArray<uint32> OccupiedSlots;
+		Shard.KeyToSlot.GenerateValueArray(OccupiedSlots);
+
+		for (uint32 LocalIndex : OccupiedSlots)
+		{
+			FContextSlot& Slot = Shard.Slots[LocalIndex];
+			Slot.OwnerPrev = INDEX_NONE;
+			Slot.OwnerNext = INDEX_NONE;
+			TrackedFilter.Remove(Slot.OwnerIndex);
+			const FAsyncContextId Id = MakeId(PartitionIndex, ShardIndex, LocalIndex, Slot);
+			RemovedContexts.Add({ Id, ReleaseSlot(Shard, LocalIndex) });
+		}
+		Shard.OwnerHeads.Reset();
+	}
+
+	{
+		// slots keep their generations so identifiers of this world stay stale after partition is reused
+		FWriteScopeLock Lock(PartitionLock);
+		Partition->World = nullptr;
+		FreePartitions.Add(PartitionIndex);
+	}
+
+	// pages of released contexts are not kept for the next world
+	Partition->Arena.Trim();
+
+	if (RemovedContexts.Num())
+	{
+		NumContexts.fetch_sub(RemovedContexts.Num());
+		ObjectListener.UpdateState();
+	}
+
+	UE_LOG(LogEnhancedAction, Verbose, TEXT("Released %d contexts of world %s"), RemovedContexts.Num(), *GetNameSafe(World));
+
+	for (FReleasedContext& Entry : RemovedContexts)
+	{
+		RecycleContext(Entry.Id, MoveTemp(Entry.Context));
+	}
+}
+
+bool FEnhancedAsyncContextManager::TickReaper(float DeltaTime)
+{
+	if (NumExpiringContexts.load(std::memory_order_relaxed) == 0)
+	{
+		return true;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FEnhancedAsyncContextManager::TickReaper);
+
+	// owners of registered slots must be alive to report evictions
+	FlushPendingTeardown();
+
+	struct FExpiredContext
+	{
+		FAsyncContextId Id;
+		FString OwnerName;
+		double Age;
+	};
+	TArray<FExpiredContext, TInlineAllocator<8>> Expired;
+
+	int32 Budget = UEnhancedAsyncContextSettings::Get()->GetReaperEntriesPerFrame();
+	const double Now = FPlatformTime::Seconds();
+
+	// each shard is visited at most once per tick, sweep continues from saved position next frame
+	FReaperCursor& Cursor = ReaperCursor;
+	for (uint32 Step = 0; Step < MaxPartitions * NumShards && Budget > 0; ++Step)
+	{
+		if (FContextPartition* Partition = GetPartition(Cursor.PartitionIndex))
+		{
+			FContextShard& Shard = Partition->Shards[Cursor.ShardIndex];
+			FReadScopeLock Lock(Shard.Lock);
+
+			const uint32 NumSlots = Shard.Slots.Num();
+			for (; Cursor.SlotIndex < NumSlots && Budget > 0; ++Cursor.SlotIndex, --Budget)
+			{
+				const FContextSlot& Slot = Shard.Slots[Cursor.SlotIndex];
+				if (Slot.Context.IsValid() && Slot.TimeToLive > 0.f && Now - Slot.CreationTime > Slot.TimeToLive)
+				{
+					const FAsyncContextId Id = MakeId(Cursor.PartitionIndex, Cursor.ShardIndex, Cursor.SlotIndex, Slot);
+					Expired.Add({ Id, GetPathNameSafe(Slot.Context->GetOwningObject()), Now - Slot.CreationTime });
+				}
+			}
+
+			if (Cursor.SlotIndex < NumSlots)
+			{ // budget exhausted within shard
+				break;
+			}
+		}
+
+		Cursor.SlotIndex = 0;
+		if (++Cursor.ShardIndex == NumShards)
+		{
+			Cursor.ShardIndex = 0;
+			Cursor.PartitionIndex = (Cursor.PartitionIndex + 1) & (MaxPartitions - 1);
+		}
+	}
+
+	for (const FExpiredContext& Entry : Expired)
+	{
+		if (DestroyContext(Entry.Id).GetValue() != 0)
+		{
+			UE_LOG(LogEnhancedAction, Log, TEXT("Evicted context %s of %s after %.1f s"), *Entry.Id.ToString(), *Entry.OwnerName, Entry.Age);
+		}
+	}
+
+	return true;
 }
 
 void FEnhancedAsyncContextManager::FObjectListener::OnUObjectArrayShutdown()
@@ -295,18 +1091,85 @@ void FEnhancedAsyncContextManager::FObjectListener::OnUObjectArrayShutdown()
 
 void FEnhancedAsyncContextManager::OnShutdown()
 {
-	FScopeLock Lock(&MapCriticalSection);
-	ObjectListener.DisableListener();
-	ObjectCollector.Reset();
-	ActionContexts.Empty();
-	TrackedObjects.Empty();
+	{
+		FScopeLock Lock(&StateCriticalSection);
+		ObjectListener.DisableListener();
+		ObjectCollector.Reset();
+	}
+
+	TrackedFilter.Reset();
+
+	{
+		FScopeLock Lock(&PendingCriticalSection);
+		for (TArray<const UObject*>& Owners : PendingOwners)
+		{
+			Owners.Empty();
+		}
+		PendingOwnersAnyPartition.Empty();
+		PendingPartitions = 0;
+		NumPendingOwners.store(0);
+		DeferredReleases.Empty();
+		NumDeferredReleases.store(0);
+	}
+
+	for (FResolvedContext& Entry : ResolveCache)
+	{
+		Entry = FResolvedContext();
+	}
+	for (FResolvedOwner& Entry : ResolveOwnerCache)
+	{
+		Entry = FResolvedOwner();
+	}
+
+	for (uint32 PartitionIndex = 0; PartitionIndex < MaxPartitions; ++PartitionIndex)
+	{
+		FContextPartition* Partition = GetPartition(PartitionIndex);
+		if (Partition == nullptr)
+		{
+			continue;
+		}
+
+		for (FContextShard& Shard : Partition->Shards)
+		{
+			FWriteScopeLock Lock(Shard.Lock);
+			Shard.Slots.Empty();
+			Shard.FreeSlots.Empty();
+			Shard.KeyToSlot.Empty();
+			Shard.OwnerHeads.Empty();
+			Shard.ReferenceSlots.Empty();
+		}
+	}
+	NumContexts.store(0);
+	NumExpiringContexts.store(0);
+
+	{
+		FWriteScopeLock Lock(PartitionLock);
+		WorldToPartition.Empty();
+		FreePartitions.Empty();
+		for (uint32 PartitionIndex = 0; PartitionIndex < NumAllocatedPartitions; ++PartitionIndex)
+		{
+			GetPartition(PartitionIndex)->World = nullptr;
+			if (PartitionIndex != GlobalPartition)
+			{
+				FreePartitions.Add(PartitionIndex);
+			}
+		}
+	}
+
+	ContextPool.Empty();
 
 	FCoreDelegates::OnExit.RemoveAll(this);
+	FCoreDelegates::OnEndFrame.RemoveAll(this);
+	FCoreUObjectDelegates::GetPostPurgeGarbageDelegate().RemoveAll(this);
+	FWorldDelegates::OnWorldCleanup.RemoveAll(this);
+	FTSTicker::GetCoreTicker().RemoveTicker(ReaperTickerHandle);
 }
 
 void FEnhancedAsyncContextManager::FObjectListener::UpdateState()
 {
-	const int32 NumContexts = Owner->ActionContexts.Num();
+	FScopeLock Lock(&Owner->StateCriticalSection);
+
+	const int32 NumContexts = Owner->NumContexts.load();
 	if (bEnabled && NumContexts == 0)
 	{
 		DisableListener();
@@ -319,12 +1182,81 @@ void FEnhancedAsyncContextManager::FObjectListener::UpdateState()
 
 void FEnhancedAsyncContextManager::FObjectListener::EnableListener()
 {
-	GUObjectArray.AddUObjectDeleteListener(this);
-	bEnabled = true;
+	if (!bEnabled)
+	{
+		GUObjectArray.AddUObjectDeleteListener(this);
+		bEnabled = true;
+	}
 }
 
 void FEnhancedAsyncContextManager::FObjectListener::DisableListener()
 {
-	GUObjectArray.RemoveUObjectDeleteListener(this);
-	bEnabled = false;
+	if (bEnabled)
+	{
+		GUObjectArray.RemoveUObjectDeleteListener(this);
+		bEnabled = false;
+	}
+}
+
+FEnhancedAsyncContextManager::FTrackedObjectFilter::~FTrackedObjectFilter()
+{
+	Reset();
+}
+
+void FEnhancedAsyncContextManager::FTrackedObjectFilter::Initialize()
+{
+	if (!IsInitialized())
+	{
+		// object array capacity is fixed at startup, so bitset is never reallocated while listener reads it
+		NumObjects = GUObjectArray.GetObjectArrayCapacity();
+		const int32 NumWords = FMath::DivideAndRoundUp(NumObjects, 64);
+		Partitions.store(new std::atomic<uint8>[NumObjects](), std::memory_order_release);
+		Words.store(new std::atomic<uint64>[NumWords](), std::memory_order_release);
+	}
+}
+
+void FEnhancedAsyncContextManager::FTrackedObjectFilter::Reset()
+{
+	delete[] Words.exchange(nullptr);
+	delete[] Partitions.exchange(nullptr);
+	NumObjects = 0;
+}
+
+void FEnhancedAsyncContextManager::FTrackedObjectFilter::Add(int32 ObjectIndex, uint32 PartitionIndex)
+{
+	std::atomic<uint64>* Data = Words.load(std::memory_order_relaxed);
+	std::atomic<uint8>* PartitionData = Partitions.load(std::memory_order_relaxed);
+	if (Data && PartitionData && ObjectIndex >= 0 && ObjectIndex < NumObjects)
+	{
+		// owner registered in another partition too falls back to lookup in all of them
+		const uint8 Entry = static_cast<uint8>(PartitionIndex + 1);
+		uint8 Expected = 0;
+		if (!PartitionData[ObjectIndex].compare_exchange_strong(Expected, Entry, std::memory_order_relaxed) && Expected != Entry)
+		{
+			PartitionData[ObjectIndex].store(AnyPartition, std::memory_order_relaxed);
+		}
+		Data[ObjectIndex >> 6].fetch_or(1ull << (ObjectIndex & 63), std::memory_order_relaxed);
+	}
+}
+
+void FEnhancedAsyncContextManager::FTrackedObjectFilter::Remove(int32 ObjectIndex)
+{
+	std::atomic<uint64>* Data = Words.load(std::memory_order_relaxed);
+	std::atomic<uint8>* PartitionData = Partitions.load(std::memory_order_relaxed);
+	if (Data && PartitionData && ObjectIndex >= 0 && ObjectIndex < NumObjects)
+	{
+		Data[ObjectIndex >> 6].fetch_and(~(1ull << (ObjectIndex & 63)), std::memory_order_relaxed);
+		PartitionData[ObjectIndex].store(0, std::memory_order_relaxed);
+	}
+}
+
+uint32 FEnhancedAsyncContextManager::FTrackedObjectFilter::GetPartition(int32 ObjectIndex) const
+{
+	const std::atomic<uint8>* PartitionData = Partitions.load(std::memory_order_acquire);
+	if (PartitionData && ObjectIndex >= 0 && ObjectIndex < NumObjects)
+	{
+		const uint8 Entry = PartitionData[ObjectIndex].load(std::memory_order_relaxed);
+		return Entry != 0 && Entry != AnyPartition ? Entry - 1u : AnyPartition;
+	}
+	return AnyPartition;
 }
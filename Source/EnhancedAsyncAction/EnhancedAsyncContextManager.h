@@ -5,19 +5,36 @@
 #include "UObject/GCObject.h"
 #include "UObject/UObjectArray.h"
 #include "HAL/CriticalSection.h"
+#include "Containers/StaticArray.h"
+#include "Containers/Ticker.h"
 #include "Templates/ValueOrError.h"
+#include <atomic>
+#include "EnhancedAsyncContextArena.h"
 #include "EnhancedAsyncContextHandle.h"
+#include "EnhancedAsyncContextPool.h"
 
 #define UE_API ENHANCEDASYNCACTION_API
 
 struct FEnhancedAsyncActionContextHandle;
 struct FEnhancedLatentActionContextHandle;
 struct FLatentCallInfo;
+class UWorld;
 
 /**
  * Manager class for async action context data.
  *
  * For each instance of proxy class it can store one instance of context data
+ *
+ * Registry is partitioned by world of the owning object, so worlds living in one process (PIE clients, in-process servers)
+ * do not contend with each other and world cleanup drops only contexts of that world.
+ * Each partition is split into shards selected by owning object, each guarded by its own reader/writer lock,
+ * so lookups from accessor thunks do not block each other and writers only contend within one shard.
+ *
+ * Contexts are stored in dense per-shard slot arrays addressed by generational identifiers,
+ * resolving an identifier is an array access and stale identifiers are rejected by generation mismatch.
+ *
+ * Async action contexts that are never released are evicted after the time to live configured for action class,
+ * the reaper checks a bounded number of slots each frame.
  */
 class UE_API FEnhancedAsyncContextManager
 {
@@ -34,6 +51,13 @@ public:
 	 */
 	TValueOrError<FEnhancedAsyncActionContextHandle, FString> CreateContext(const UObject* Action, FName InnerProperty);
 
+	/**
+	 * Set context for the given action and hand out created instance so caller does not resolve it again
+	 *
+	 * @return registered handle for public use
+	 */
+	TValueOrError<FEnhancedAsyncActionContextHandle, FString> CreateContext(const UObject* Action, FName InnerProperty, TSharedPtr<FEnhancedAsyncActionContext>& OutContext);
+
 	/**
 	 * Set context for the given action
 	 *
@@ -41,6 +65,15 @@ public:
 	 */
 	TValueOrError<FEnhancedLatentActionContextHandle, FString> CreateContext(const FLatentCallInfo& CallInfo);
 
+	/**
+	 * Register another backend for a live context, previous context object is released.
+	 *
+	 * Used to move a context that was not set up yet to a backend selected by its captures.
+	 *
+	 * @return false if identifier is stale or context is reported to garbage collection
+	 */
+	bool ReplaceContext(const FAsyncContextId& ContextId, TSharedRef<FEnhancedAsyncActionContext> Context);
+
 	/**
 	 * Destroy context by identifier
 	 */
@@ -67,6 +100,16 @@ public:
 	 */
 	FEnhancedLatentActionContextHandle FindContextHandle(const FLatentCallInfo& CallInfo);
 
+	/**
+	 * Resolve context bound to action object without building public handle
+	 *
+	 * @param Action owning action object
+	 * @param OutContextId identifier of found context
+	 *
+	 * @return bound context object, null if there is none
+	 */
+	TSharedPtr<FEnhancedAsyncActionContext> FindContext(const UObject* Action, FAsyncContextId& OutContextId);
+
 	/**
 	 * Resolve context instance from given latent handle
 	 *
@@ -78,20 +121,89 @@ public:
 	TSharedPtr<FEnhancedAsyncActionContext> FindContext(const FAsyncContextId& ContextId, EResolveErrorMode OnError = EResolveErrorMode::AllowNull);
 	TSharedPtr<FEnhancedAsyncActionContext> FindContext(const FAsyncContextHandleBase& Handle, EResolveErrorMode OnError = EResolveErrorMode::AllowNull);
 
+	/**
+	 * Resolve context instance on game thread without pinning it
+	 *
+	 * Identifier is validated by its serial against a cache of contexts already resolved on game thread,
+	 * a hit takes no lock and touches no reference count. Off game thread use FindContext.
+	 *
+	 * @param ContextId  requestor identifier
+	 * @param OnError error handling mode
+	 *
+	 * @return bound context object, valid until the context is destroyed
+	 */
+	FEnhancedAsyncActionContext* FindContextOnGameThread(const FAsyncContextId& ContextId, EResolveErrorMode OnError = EResolveErrorMode::AllowNull);
+
+	/**
+	 * Resolve context bound to action object on game thread without pinning it
+	 *
+	 * @param Action owning action object
+	 * @param OutContextId identifier of found context
+	 *
+	 * @return bound context object, null if there is none
+	 */
+	FEnhancedAsyncActionContext* FindContextOnGameThread(const UObject* Action, FAsyncContextId& OutContextId);
+
+	/**
+	 * Release contexts destroyed off game thread.
+	 *
+	 * Game thread may still hold them resolved without pinning, so they are kept alive until next frame end.
+	 */
+	void FlushDeferredReleases();
+
+	/**
+	 * Release contexts of owners deleted since last flush.
+	 *
+	 * Deleted owners are queued by the delete listener and processed in batch after garbage purge or at frame end.
+	 */
+	void FlushPendingTeardown();
+
+	/**
+	 * Pool of released contexts and their value memory
+	 */
+	FEnhancedAsyncContextPool& GetContextPool() { return ContextPool; }
+
+	/**
+	 * Find arena of the world the context is registered in
+	 *
+	 * @return null if owner class is not opted into arena allocation
+	 */
+	FEnhancedAsyncContextArena* FindContextArena(const FAsyncContextId& ContextId, const UObject* Owner) const;
+
+	/**
+	 * Occupancy and fallback counters summed over arenas of all worlds
+	 */
+	FEnhancedAsyncContextArena::FStats GetArenaStats() const;
+
+	/**
+	 * Start reporting context to garbage collection after its layout gained object references
+	 */
+	void NotifyContextReferencesAdded(const FAsyncContextId& ContextId);
+
 private:
 
 	FEnhancedAsyncContextManager();
 	~FEnhancedAsyncContextManager();
 
-	void SetContextInternal(FAsyncContextId ContextId, TSharedRef<FEnhancedAsyncActionContext> Context, const UObject* TrackedOwner);
+	struct FContextKey;
+
+	FAsyncContextId SetContextInternal(uint32 PartitionIndex, const FContextKey& Key, TSharedRef<FEnhancedAsyncActionContext> Context, float TimeToLive = 0.f);
+
+	// Return context removed from registry to the pool if nothing else holds it
+	void RecycleContext(const FAsyncContextId& ContextId, TSharedPtr<FEnhancedAsyncActionContext>&& Context);
 
 	TSharedPtr<FEnhancedAsyncActionContext> HandleError(EResolveErrorMode OnError, const TCHAR* Message) const;
 private:
 	void AddReferencedObjects(FReferenceCollector& Collector);
 
-	void OnObjectDeleted(const UObject* Action);
+	void OnObjectDeleted(const UObject* Object, uint32 PartitionIndex);
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	bool TickReaper(float DeltaTime);
 	void OnShutdown();
 
+	bool HasPendingTeardown() const { return NumPendingOwners.load(std::memory_order_relaxed) != 0; }
+	bool HasDeferredReleases() const { return NumDeferredReleases.load(std::memory_order_relaxed) != 0; }
+
 	struct FGCCollector : public FGCObject
 	{
 		explicit FGCCollector(FEnhancedAsyncContextManager* Owner) : Owner(Owner) { }
@@ -125,15 +237,248 @@ private:
 
 	FObjectListener ObjectListener { this };
 
+	// Number of registry shards per partition, must be power of two
+	static constexpr uint32 ShardBits = 4;
+	static constexpr uint32 NumShards = 1 << ShardBits;
+
+	// Maximum number of world partitions, must be power of two
+	static constexpr uint32 PartitionBits = 6;
+	static constexpr uint32 MaxPartitions = 1 << PartitionBits;
+
+	// Partition of owners outside of any world, always allocated
+	static constexpr uint32 GlobalPartition = 0;
+
+	/**
+	 * Lock-free membership set of tracked owners keyed by their object array index.
+	 *
+	 * Delete listener receives every object destroyed in the process, the filter rejects untracked ones
+	 * with a single load before any lock or map probe is made.
+	 * Partition of tracked owner is kept aside so its teardown visits only that partition.
+	 */
+	struct FTrackedObjectFilter
+	{
+		~FTrackedObjectFilter();
+
+		bool IsInitialized() const { return Words.load(std::memory_order_acquire) != nullptr; }
+		// Allocate bitset for the whole object array capacity
+		void Initialize();
+		void Reset();
+
+		void Add(int32 ObjectIndex, uint32 PartitionIndex);
+		void Remove(int32 ObjectIndex);
+
+		// Partition owner contexts are registered in, AnyPartition if unknown or more than one
+		uint32 GetPartition(int32 ObjectIndex) const;
+		static constexpr uint8 AnyPartition = MAX_uint8;
+
+		FORCEINLINE bool Contains(int32 ObjectIndex) const
+		{
+			const std::atomic<uint64>* Data = Words.load(std::memory_order_acquire);
+			return Data && ObjectIndex >= 0 && ObjectIndex < NumObjects
+				&& (Data[ObjectIndex >> 6].load(std::memory_order_relaxed) & (1ull << (ObjectIndex & 63))) != 0;
+		}
+	private:
+		std::atomic<std::atomic<uint64>*> Words { nullptr };
+		// Partition index plus one per object, zero if not recorded
+		std::atomic<std::atomic<uint8>*> Partitions { nullptr };
+		int32 NumObjects = 0;
+	};
+
+	static_assert(MaxPartitions < FTrackedObjectFilter::AnyPartition, "Partition index must fit filter entry");
+
+	FTrackedObjectFilter TrackedFilter;
+
+	// Guards deleted owners queue
+	FCriticalSection PendingCriticalSection;
+
+	// Deleted tracked owners waiting for batched teardown, bucketed by partition their contexts are registered in.
+	// Pointers are used only as keys, queue is flushed before any registration could reuse the address.
+	TStaticArray<TArray<const UObject*>, MaxPartitions> PendingOwners;
+	// Deleted owners with unknown partition, looked up in every allocated partition
+	TArray<const UObject*> PendingOwnersAnyPartition;
+	// Bit per partition with pending owners
+	uint64 PendingPartitions = 0;
+	static_assert(MaxPartitions <= 64, "Pending partitions must fit mask");
+
+	std::atomic<int32> NumPendingOwners { 0 };
+
+	// Context removed from registry along with identifier it was registered with
+	struct FReleasedContext
+	{
+		FAsyncContextId Id;
+		TSharedPtr<FEnhancedAsyncActionContext> Context;
+	};
+
+	// Contexts destroyed off game thread, guarded by pending queue lock
+	TArray<FReleasedContext> DeferredReleases;
+
+	std::atomic<int32> NumDeferredReleases { 0 };
+
+	// Contexts resolved on game thread, only accessed by game thread.
+	// Entry is evicted before registry drops its reference, so cached pointer is alive while entry exists.
+	struct FResolvedContext
+	{
+		FAsyncContextId Id;
+		FEnhancedAsyncActionContext* Context = nullptr;
+	};
+
+	static constexpr uint32 ResolveCacheSize = 256;
+	TStaticArray<FResolvedContext, ResolveCacheSize> ResolveCache;
+
+	static uint32 GetResolveCacheIndex(const FAsyncContextId& ContextId)
+	{
+		return ((GetLocalIndex(ContextId) << ShardBits) | GetShardIndex(ContextId)) & (ResolveCacheSize - 1);
+	}
+
+	// Identifiers of contexts last resolved by owner on game thread, validated by identifier cache on hit
+	struct FResolvedOwner
+	{
+		const UObject* Owner = nullptr;
+		FAsyncContextId Id;
+	};
+
+	TStaticArray<FResolvedOwner, ResolveCacheSize> ResolveOwnerCache;
+
+	static uint32 GetResolveCacheIndex(const UObject* Owner) { return ::PointerHash(Owner) & (ResolveCacheSize - 1); }
+
+	// Drop game thread cache entry of released context
+	void EvictResolvedContext(const FAsyncContextId& ContextId);
+
 	TSharedPtr<FEnhancedAsyncActionContext> DummyContext;
 
-	mutable FCriticalSection MapCriticalSection;
+	// Exact registration key of a context: action object or latent call
+	struct FContextKey
+	{
+		const UObject* Owner = nullptr;
+		int32 UUID = 0;
+		int32 CallID = 0;
+
+		bool operator==(const FContextKey& Other) const
+		{
+			return Owner == Other.Owner && UUID == Other.UUID && CallID == Other.CallID;
+		}
+
+		friend uint32 GetTypeHash(const FContextKey& Key)
+		{
+			return HashCombineFast(::PointerHash(Key.Owner), HashCombineFast(Key.UUID, Key.CallID));
+		}
+	};
+
+	struct FContextSlot
+	{
+		// Context object, null for free slots
+		TSharedPtr<FEnhancedAsyncActionContext> Context;
+		// Key the context was registered with
+		FContextKey Key;
+		// Object array index of owner, owner may be already destroyed when slot is released
+		int32 OwnerIndex = INDEX_NONE;
+		// Time context was registered at
+		double CreationTime = 0.0;
+		// Time after creation the context is evicted at, zero if it never expires
+		float TimeToLive = 0.f;
+		// Position in shard list of contexts holding object references
+		int32 ReferenceIndex = INDEX_NONE;
+		// Neighbour slots in list of contexts registered by the same owner
+		int32 OwnerPrev = INDEX_NONE;
+		int32 OwnerNext = INDEX_NONE;
+		// Slot generation, bumped on every release
+		uint32 Generation = 1;
+	};
+
+	struct FContextShard
+	{
+		mutable FRWLock Lock;
+
+		// Dense slot storage, identifiers address it by local index
+		TArray<FContextSlot> Slots;
+
+		// Released slots available for reuse
+		TArray<uint32> FreeSlots;
+
+		// Registration key to a local slot index
+		TMap<FContextKey, uint32> KeyToSlot;
+
+		// Owning object to the first slot of its context list (async action and latent)
+		TMap<const UObject*, int32> OwnerHeads;
+
+		// Slots with contexts that hold object references, only these are visited by garbage collection
+		TArray<uint32> ReferenceSlots;
+	};
+
+	struct FContextPartition
+	{
+		// World served by this partition, null for global or unused partition
+		const UWorld* World = nullptr;
+
+		// Registry shards selected by owning object
+		TStaticArray<FContextShard, NumShards> Shards;
+
+		// Memory of short-lived contexts of the world
+		FEnhancedAsyncContextArena Arena;
+	};
+
+	static uint32 GetOwnerShardIndex(const UObject* Owner) { return ::PointerHash(Owner) & (NumShards - 1); }
+	static uint32 GetShardIndex(const FAsyncContextId& ContextId) { return ContextId.GetIndex() & (NumShards - 1); }
+	static uint32 GetPartitionIndex(const FAsyncContextId& ContextId) { return (ContextId.GetIndex() >> ShardBits) & (MaxPartitions - 1); }
+	static uint32 GetLocalIndex(const FAsyncContextId& ContextId) { return ContextId.GetIndex() >> (ShardBits + PartitionBits); }
+
+	// World that owns contexts of the object, null if object is outside of any world
+	static const UWorld* GetOwnerWorld(const UObject* Owner);
+
+	FContextPartition* GetPartition(uint32 PartitionIndex) const { return Partitions[PartitionIndex].load(std::memory_order_acquire); }
+	// Find shard addressed by identifier, null if its partition was never allocated
+	FContextShard* FindShard(const FAsyncContextId& ContextId) const;
+
+	// Find partition serving the world, INDEX_NONE if world has no contexts
+	int32 FindPartition(const UWorld* World) const;
+	// Find partition serving the world or assign a new one
+	uint32 FindOrAddPartition(const UWorld* World);
+
+	// Make public identifier for occupied slot
+	static FAsyncContextId MakeId(uint32 PartitionIndex, uint32 ShardIndex, uint32 LocalIndex, const FContextSlot& Slot);
+	// Find occupied slot for identifier, shard must be locked
+	static FContextSlot* FindSlot(FContextShard& Shard, const FAsyncContextId& ContextId);
+	// Add or remove slot from list of contexts reported to garbage collection, shard must be write locked
+	static void AddReferenceSlot(FContextShard& Shard, uint32 LocalIndex);
+	static void RemoveReferenceSlot(FContextShard& Shard, uint32 LocalIndex);
+	// Add or remove slot from context list of its owner, shard must be write locked
+	static void LinkOwnerSlot(FContextShard& Shard, uint32 LocalIndex);
+	static void UnlinkOwnerSlot(FContextShard& Shard, uint32 LocalIndex);
+	// Release occupied slot and move out its context, slot must be unlinked from owner list, shard must be write locked
+	TSharedPtr<FEnhancedAsyncActionContext> ReleaseSlot(FContextShard& Shard, uint32 LocalIndex);
+
+	// Partitions are allocated on demand and kept until manager is destroyed,
+	// partitions of cleaned up worlds are reused with their slot generations intact.
+	std::atomic<FContextPartition*> Partitions[MaxPartitions] = { };
+
+	// Guards world to partition mapping
+	mutable FRWLock PartitionLock;
+	TMap<const UWorld*, uint32> WorldToPartition;
+	TArray<uint32> FreePartitions;
+	uint32 NumAllocatedPartitions = 0;
+
+	// Total number of registered contexts across all shards
+	std::atomic<int32> NumContexts { 0 };
+
+	// Number of registered contexts with time to live
+	std::atomic<int32> NumExpiringContexts { 0 };
+
+	// Position of expiration sweep, only used by game thread ticker
+	struct FReaperCursor
+	{
+		uint32 PartitionIndex = 0;
+		uint32 ShardIndex = 0;
+		uint32 SlotIndex = 0;
+	};
+
+	FReaperCursor ReaperCursor;
+
+	FTSTicker::FDelegateHandle ReaperTickerHandle;
 
-	// All known async contexts
-	TMap<FAsyncContextId, TSharedPtr<FEnhancedAsyncActionContext>> ActionContexts;
+	// Guards listener registration and collector creation
+	FCriticalSection StateCriticalSection;
 
-	// Owning object to a context identifier (async action or latent)
-	TMultiMap<const UObject*, FAsyncContextId> TrackedObjects;
+	FEnhancedAsyncContextPool ContextPool;
 };
 
 #undef UE_API
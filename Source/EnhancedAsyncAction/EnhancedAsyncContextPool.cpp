@@ -0,0 +1,225 @@
+﻿// Copyright 2025, Aquanox.
+
+#include "EnhancedAsyncContextPool.h"
+
+#include "EnhancedAsyncContextImpl.h"
+#include "EnhancedAsyncContextLayout.h"
+#include "EnhancedAsyncContextManager.h"
+#include "EnhancedAsyncContextSettings.h"
+#include "EnhancedAsyncContextShared.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/GCObject.h"
+
+static FAutoConsoleCommand GDumpContextPoolStatsCommand(
+	TEXT("EnhancedAsyncAction.DumpPoolStats"),
+	TEXT("Print context pool hit and miss counters"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		const FEnhancedAsyncContextPool::FStats Stats = FEnhancedAsyncContextManager::Get().GetContextPool().GetStats();
+		UE_LOG(LogEnhancedAction, Display, TEXT("Context pool: contexts hit=%lld miss=%lld pooled=%d, values hit=%lld miss=%lld pooled=%d, layouts=%d"),
+			Stats.ContextHits, Stats.ContextMisses, Stats.NumPooledContexts,
+			Stats.ValueHits, Stats.ValueMisses, Stats.NumPooledValues, Stats.NumLayouts);
+	})
+);
+
+bool FEnhancedAsyncContextPool::IsEnabled()
+{
+	return UEnhancedAsyncContextSettings::Get()->IsContextPoolEnabled();
+}
+
+TSharedRef<FEnhancedAsyncActionContext_PropertyBag> FEnhancedAsyncContextPool::AcquireContext(const UObject* Owner)
+{
+	if (!IsEnabled())
+	{
+		return MakeShared<FEnhancedAsyncActionContext_PropertyBag>(Owner);
+	}
+
+	TSharedPtr<FEnhancedAsyncActionContext_PropertyBag> Context;
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (!FreeContexts.IsEmpty())
+		{
+			Context = FreeContexts.Pop(EAllowShrinking::No);
+			++ContextHits;
+		}
+		else
+		{
+			++ContextMisses;
+		}
+	}
+
+	if (!Context.IsValid())
+	{
+		return MakeShared<FEnhancedAsyncActionContext_PropertyBag>(Owner);
+	}
+
+	Context->Reinitialize(Owner);
+	return Context.ToSharedRef();
+}
+
+void FEnhancedAsyncContextPool::ReleaseContext(TSharedPtr<FEnhancedAsyncActionContext_PropertyBag> Context)
+{
+	check(Context.IsValid());
+
+	const UEnhancedAsyncContextSettings* Settings = UEnhancedAsyncContextSettings::Get();
+
+	FInstancedPropertyBag Value = Context->DetachValue();
+	const UPropertyBag* Layout = Value.GetPropertyBagStruct();
+
+	bool bKeepValue = false;
+	if (Layout != nullptr)
+	{
+		FScopeLock Lock(&CriticalSection);
+		const TArray<FInstancedPropertyBag>* Bucket = FreeValues.Find(Layout);
+		bKeepValue = Bucket && Bucket->Num() < Settings->GetMaxPooledValuesPerLayout();
+	}
+
+	if (bKeepValue)
+	{
+		// reset captured values to defaults outside of the lock, it may release strings and containers
+		Layout->ClearScriptStruct(Value.GetMutableValue().GetMemory());
+
+		FScopeLock Lock(&CriticalSection);
+		if (TArray<FInstancedPropertyBag>* Bucket = FreeValues.Find(Layout))
+		{
+			Bucket->Add(MoveTemp(Value));
+			++NumPooledValues;
+		}
+	}
+
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (FreeContexts.Num() < Settings->GetMaxPooledContexts())
+		{
+			FreeContexts.Add(MoveTemp(Context));
+		}
+	}
+}
+
+const UPropertyBag* FEnhancedAsyncContextPool::FindLayout(const FString& LayoutKey) const
+{
+	FScopeLock Lock(&CriticalSection);
+	const UPropertyBag* const* Layout = KeyToLayout.Find(LayoutKey);
+	return Layout ? *Layout : nullptr;
+}
+
+void FEnhancedAsyncContextPool::RegisterLayout(const FString& LayoutKey, const UPropertyBag* Layout)
+{
+	if (Layout == nullptr)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+	if (!KeyToLayout.Contains(LayoutKey))
+	{
+		KeyToLayout.Add(LayoutKey, Layout);
+		if (!FreeValues.Contains(Layout))
+		{
+			FreeValues.Add(Layout);
+			Layouts.Add(Layout);
+		}
+	}
+}
+
+bool FEnhancedAsyncContextPool::AcquireValue(const UPropertyBag* Layout, FInstancedPropertyBag& OutValue)
+{
+	check(Layout != nullptr);
+
+	{
+		FScopeLock Lock(&CriticalSection);
+		TArray<FInstancedPropertyBag>* Bucket = FreeValues.Find(Layout);
+		if (Bucket && !Bucket->IsEmpty())
+		{
+			OutValue = Bucket->Pop(EAllowShrinking::No);
+			--NumPooledValues;
+			++ValueHits;
+			return true;
+		}
+		++ValueMisses;
+	}
+
+	// layout is already resolved, only value memory is allocated
+	OutValue.InitializeFromBagStruct(Layout);
+	return false;
+}
+
+bool FEnhancedAsyncContextPool::WarmUpLayout(const FString& Definition)
+{
+	if (!IsEnabled() || Definition.IsEmpty() || FindLayout(Definition) != nullptr)
+	{
+		return false;
+	}
+
+	bool bComplete;
+	const UPropertyBag* Layout = FEnhancedAsyncContextLayout::FindOrAddDefinition(Definition, bComplete);
+	if (Layout == nullptr || !bComplete)
+	{ // type may be loaded later, retried on next map load
+		return false;
+	}
+
+	TStringBuilder<256> PropertyLayoutKey;
+	PropertyLayoutKey.AppendChar(TEXT('@'));
+	for (const FPropertyBagPropertyDesc& Desc : Layout->GetPropertyDescs())
+	{
+		FEnhancedAsyncActionContext_PropertyBagBase::AppendPropertyLayoutKey(PropertyLayoutKey, Desc);
+	}
+
+	FInstancedPropertyBag Value;
+	Value.InitializeFromBagStruct(Layout);
+
+	// garbage collection traits are derived once per layout
+	FEnhancedAsyncContextLayout::FindOrAdd(Layout);
+
+	// setup node passes config string, variadic setter passes captured properties
+	RegisterLayout(Definition, Layout);
+	RegisterLayout(PropertyLayoutKey.ToString(), Layout);
+
+	// value built for the layout serves its first call
+	FScopeLock Lock(&CriticalSection);
+	TArray<FInstancedPropertyBag>* Bucket = FreeValues.Find(Layout);
+	if (Bucket && Bucket->Num() < UEnhancedAsyncContextSettings::Get()->GetMaxPooledValuesPerLayout())
+	{
+		Bucket->Add(MoveTemp(Value));
+		++NumPooledValues;
+	}
+	return true;
+}
+
+FEnhancedAsyncContextPool::FStats FEnhancedAsyncContextPool::GetStats() const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	FStats Stats;
+	Stats.ContextHits = ContextHits;
+	Stats.ContextMisses = ContextMisses;
+	Stats.ValueHits = ValueHits;
+	Stats.ValueMisses = ValueMisses;
+	Stats.NumPooledContexts = FreeContexts.Num();
+	Stats.NumPooledValues = NumPooledValues;
+	Stats.NumLayouts = Layouts.Num();
+	return Stats;
+}
+
+void FEnhancedAsyncContextPool::Empty()
+{
+	// pooled objects are destroyed outside of the lock
+	TArray<TSharedPtr<FEnhancedAsyncActionContext_PropertyBag>> Contexts;
+	TMap<const UPropertyBag*, TArray<FInstancedPropertyBag>> Values;
+	{
+		FScopeLock Lock(&CriticalSection);
+		Contexts = MoveTemp(FreeContexts);
+		Values = MoveTemp(FreeValues);
+		KeyToLayout.Empty();
+		Layouts.Empty();
+		NumPooledValues = 0;
+	}
+}
+
+void FEnhancedAsyncContextPool::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	FScopeLock Lock(&CriticalSection);
+	// pooled values only hold default data, keeping their layouts is enough
+	Collector.AddReferencedObjects(Layouts);
+}
@@ -0,0 +1,110 @@
+﻿// Copyright 2025, Aquanox.
+
+#pragma once
+
+#include "HAL/CriticalSection.h"
+#include "StructUtils/PropertyBag.h"
+#include "Templates/SharedPointer.h"
+
+#define UE_API ENHANCEDASYNCACTION_API
+
+class FEnhancedAsyncActionContext_PropertyBag;
+
+/**
+ * Recycling pool for bag-backed contexts owned by context manager.
+ *
+ * Context objects do not depend on layout and are reused for any call.
+ * Value memory is grouped by resolved bag layout and handed back to setup requests with the same layout key
+ * (config string of SetupContextContainer or the list of captured properties), so steady-state calls
+ * skip both the allocation and the layout resolution.
+ */
+class UE_API FEnhancedAsyncContextPool
+{
+public:
+	struct FStats
+	{
+		int64 ContextHits = 0;
+		int64 ContextMisses = 0;
+		int64 ValueHits = 0;
+		int64 ValueMisses = 0;
+		int32 NumPooledContexts = 0;
+		int32 NumPooledValues = 0;
+		int32 NumLayouts = 0;
+	};
+
+	FEnhancedAsyncContextPool() = default;
+	FEnhancedAsyncContextPool(const FEnhancedAsyncContextPool&) = delete;
+	FEnhancedAsyncContextPool& operator=(const FEnhancedAsyncContextPool&) = delete;
+
+	/** Is pooling enabled in project settings */
+	static bool IsEnabled();
+
+	/**
+	 * Take released context object for a new owner or make a new one if pool is empty
+	 */
+	TSharedRef<FEnhancedAsyncActionContext_PropertyBag> AcquireContext(const UObject* Owner);
+
+	/**
+	 * Return context object removed from registry.
+	 *
+	 * Context must not be referenced elsewhere, its value memory is kept if layout is known to the pool.
+	 */
+	void ReleaseContext(TSharedPtr<FEnhancedAsyncActionContext_PropertyBag> Context);
+
+	/**
+	 * Find bag layout previously resolved for layout key
+	 */
+	const UPropertyBag* FindLayout(const FString& LayoutKey) const;
+
+	/**
+	 * Remember bag layout resolved for layout key. Only registered layouts keep released value memory.
+	 */
+	void RegisterLayout(const FString& LayoutKey, const UPropertyBag* Layout);
+
+	/**
+	 * Take released value memory of given layout
+	 *
+	 * @return true if value was taken from pool, false if OutValue was freshly initialized
+	 */
+	bool AcquireValue(const UPropertyBag* Layout, FInstancedPropertyBag& OutValue);
+
+	/**
+	 * Build and register layout of capture config string ahead of its first use.
+	 *
+	 * Layout is registered for the config string of setup call and for the equivalent set of captured properties.
+	 *
+	 * @return true if a new layout was registered
+	 */
+	bool WarmUpLayout(const FString& Definition);
+
+	FStats GetStats() const;
+
+	/** Drop all pooled objects, values and known layouts */
+	void Empty();
+
+	void AddReferencedObjects(FReferenceCollector& Collector);
+
+private:
+	mutable FCriticalSection CriticalSection;
+
+	// Released context objects with detached values
+	TArray<TSharedPtr<FEnhancedAsyncActionContext_PropertyBag>> FreeContexts;
+
+	// Layout key to resolved layout
+	TMap<FString, const UPropertyBag*> KeyToLayout;
+
+	// Released value memory of each registered layout, reset to defaults
+	TMap<const UPropertyBag*, TArray<FInstancedPropertyBag>> FreeValues;
+
+	// Registered layouts kept alive for reuse
+	TArray<const UPropertyBag*> Layouts;
+
+	int32 NumPooledValues = 0;
+
+	int64 ContextHits = 0;
+	int64 ContextMisses = 0;
+	int64 ValueHits = 0;
+	int64 ValueMisses = 0;
+};
+
+#undef UE_API
@@ -10,6 +10,34 @@ const UEnhancedAsyncContextSettings* UEnhancedAsyncContextSettings::Get()
 	return GetDefault<UEnhancedAsyncContextSettings>();
 }
 
+void UEnhancedAsyncContextSettings::PostInitProperties()
+{
+	Super::PostInitProperties();
+	UpdateCachedSettings();
+}
+
+void UEnhancedAsyncContextSettings::PostReloadConfig(FProperty* PropertyThatWasLoaded)
+{
+	Super::PostReloadConfig(PropertyThatWasLoaded);
+	UpdateCachedSettings();
+}
+
+#if WITH_EDITOR
+void UEnhancedAsyncContextSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	UpdateCachedSettings();
+}
+#endif
+
+void UEnhancedAsyncContextSettings::UpdateCachedSettings()
+{
+	bHasContextTimeToLive = DefaultContextTimeToLive > 0.f || ExternalAsyncActions.ContainsByPredicate([](const FExternalAsyncActionSpec& Spec)
+	{
+		return Spec.ContextTimeToLive > 0.f;
+	});
+}
+
 const FExternalAsyncActionSpec* UEnhancedAsyncContextSettings::FindActionSpecForClass(UClass* Class) const
 {
 	for (const FExternalAsyncActionSpec& Spec : ExternalAsyncActions)
@@ -22,3 +50,59 @@ const FExternalAsyncActionSpec* UEnhancedAsyncContextSettings::FindActionSpecFor
 	}
 	return nullptr;
 }
+
+float UEnhancedAsyncContextSettings::GetContextTimeToLive(UClass* Class) const
+{
+	// called on every context creation, spec lookup resolves soft classes
+	if (!bHasContextTimeToLive)
+	{
+		return 0.f;
+	}
+
+	if (Class != nullptr)
+	{
+		const FExternalAsyncActionSpec* Spec = FindActionSpecForClass(Class);
+		if (Spec && Spec->ContextTimeToLive > 0.f)
+		{
+			return Spec->ContextTimeToLive;
+		}
+	}
+	return DefaultContextTimeToLive;
+}
+
+bool UEnhancedAsyncContextSettings::IsContextArenaEnabledForClass(const UClass* Class) const
+{
+	if (Class == nullptr || !bEnableInlineContexts)
+	{
+		return false;
+	}
+
+	for (const TSoftClassPtr<UObject>& ArenaClass : ContextArenaClasses)
+	{
+		const UClass* ResolvedClass = ArenaClass.Get();
+		if (ResolvedClass && Class->IsChildOf(ResolvedClass))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+#if WITH_EDITOR
+void UEnhancedAsyncContextSettings::AddWarmUpContextLayouts(TConstArrayView<FString> Definitions)
+{
+	const int32 NumLayouts = WarmUpContextLayouts.Num();
+	for (const FString& Definition : Definitions)
+	{
+		if (!Definition.IsEmpty())
+		{
+			WarmUpContextLayouts.AddUnique(Definition);
+		}
+	}
+
+	if (WarmUpContextLayouts.Num() != NumLayouts)
+	{
+		TryUpdateDefaultConfigFile();
+	}
+}
+#endif
@@ -26,6 +26,12 @@ struct FExternalAsyncActionSpec
 	// Should display context pin
 	UPROPERTY(EditAnywhere, Category=Spec)
 	bool bExposedContext = false;
+	// Action fires once, captures are moved out on read and context is released right away (same as metadata ConsumeAsyncContext)
+	UPROPERTY(EditAnywhere, Category=Spec)
+	bool bConsumeContextOnRead = false;
+	// Time after which unreleased context is evicted, zero to use project default
+	UPROPERTY(EditAnywhere, Category=Spec, meta=(ClampMin=0, Units=Seconds))
+	float ContextTimeToLive = 0.f;
 };
 
 /**
@@ -43,9 +49,43 @@ public:
 	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
 	virtual FName GetSectionName() const override { return TEXT("EnhancedAsyncAction"); }
 
+	UE_API virtual void PostInitProperties() override;
+	UE_API virtual void PostReloadConfig(FProperty* PropertyThatWasLoaded) override;
+#if WITH_EDITOR
+	UE_API virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	UE_API const FExternalAsyncActionSpec* FindActionSpecForClass(UClass* Class) const;
 
+	bool IsContextPoolEnabled() const { return bEnableContextPool; }
+	int32 GetMaxPooledContexts() const { return bEnableContextPool ? MaxPooledContexts : 0; }
+	int32 GetMaxPooledValuesPerLayout() const { return bEnableContextPool ? MaxPooledValuesPerLayout : 0; }
+	bool IsInlineContextEnabled() const { return bEnableInlineContexts; }
+	bool IsCaptureSharingEnabled() const { return bShareCapturePayloads; }
+
+	/** Are contexts owned by objects of the class allocated from world context arena */
+	UE_API bool IsContextArenaEnabledForClass(const UClass* Class) const;
+	uint32 GetContextArenaPageSize() const { return static_cast<uint32>(ContextArenaPageSize); }
+	int32 GetMaxContextArenaPages() const { return MaxContextArenaPages; }
+	uint32 GetContextArenaSpillFrames() const { return static_cast<uint32>(ContextArenaSpillFrames); }
+
+	/** Time after which unreleased context of the action class is evicted, zero if it never expires. No lookup is made if no time to live is configured */
+	UE_API float GetContextTimeToLive(UClass* Class) const;
+	int32 GetReaperEntriesPerFrame() const { return ReaperEntriesPerFrame; }
+
+	const TArray<FString>& GetWarmUpContextLayouts() const { return WarmUpContextLayouts; }
+#if WITH_EDITOR
+	/** Add capture config strings to warm-up list and save it to default config */
+	UE_API void AddWarmUpContextLayouts(TConstArrayView<FString> Definitions);
+#endif
+
 private:
+	// Refresh cached flags derived from config
+	void UpdateCachedSettings();
+
+	// Default or any external action sets time to live
+	bool bHasContextTimeToLive = false;
+
 	/**
 	 * List of manually registered actions to use EnhancedAsyncAction node.
 	 *
@@ -55,6 +95,86 @@ private:
 	 */
 	UPROPERTY(Config, EditAnywhere, Category=General, meta=(ConfigRestartRequired=true))
 	TArray<FExternalAsyncActionSpec> ExternalAsyncActions;
+
+	/**
+	 * Reuse released context objects and their value memory for new calls.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category=Performance)
+	bool bEnableContextPool = true;
+
+	/**
+	 * Maximum number of released context objects kept for reuse.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category=Performance, meta=(ClampMin=0, EditCondition="bEnableContextPool"))
+	int32 MaxPooledContexts = 256;
+
+	/**
+	 * Maximum number of released context values kept for reuse per context layout.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category=Performance, meta=(ClampMin=0, EditCondition="bEnableContextPool"))
+	int32 MaxPooledValuesPerLayout = 32;
+
+	/**
+	 * Store captures in inline buffer instead of property bag when all of them are bools, numbers, enums or names.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category=Performance)
+	bool bEnableInlineContexts = true;
+
+	/**
+	 * Contexts capturing identical struct or array value in the same frame share one immutable copy of it until the capture is overwritten.
+	 *
+	 * Saves a deep copy per context when a loop spawns many actions capturing the same large value.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category=Performance)
+	bool bShareCapturePayloads = true;
+
+	/**
+	 * Owner classes (async actions or objects calling latent functions) whose inline contexts are allocated from per-world arena.
+	 *
+	 * Arena pages are reclaimed in bulk once all their contexts are released. Use EnhancedAsyncAction.DumpArenaStats to size it.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category=Performance, meta=(EditCondition="bEnableInlineContexts"))
+	TArray<TSoftClassPtr<UObject>> ContextArenaClasses;
+
+	/**
+	 * Size of one context arena page in bytes.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category=Performance, meta=(ClampMin=1024, ClampMax=1048576, Units=Bytes))
+	int32 ContextArenaPageSize = 16384;
+
+	/**
+	 * Maximum number of pages of context arena of one world, contexts are allocated on heap when all pages are in use.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category=Performance, meta=(ClampMin=1))
+	int32 MaxContextArenaPages = 16;
+
+	/**
+	 * Number of frames after which arena page still holding contexts is handed over to the heap and stops counting against page limit.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category=Performance, meta=(ClampMin=1))
+	int32 ContextArenaSpillFrames = 120;
+
+	/**
+	 * Time after which context of async action that never released it is evicted.
+	 *
+	 * Zero keeps contexts until owning action object is destroyed. Can be overridden per class in external action list.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category=Performance, meta=(ClampMin=0, Units=Seconds))
+	float DefaultContextTimeToLive = 0.f;
+
+	/**
+	 * Maximum number of context entries checked for expiration each frame.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category=Performance, meta=(ClampMin=1))
+	int32 ReaperEntriesPerFrame = 256;
+
+	/**
+	 * Capture config strings of enhanced nodes whose context layouts are built at startup and on map load.
+	 *
+	 * Use EnhancedAsyncAction.RecordWarmUpLayouts console command in editor to collect them from loaded blueprints.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category=Performance, meta=(EditCondition="bEnableContextPool"))
+	TArray<FString> WarmUpContextLayouts;
 };
 
 #undef UE_API
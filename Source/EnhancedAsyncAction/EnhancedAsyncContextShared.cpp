@@ -57,6 +57,11 @@ int32 EAA::Internals::NameToIndex(const FName& Name)
 	return Idx;
 }
 
+int32 EAA::Internals::FindCaptureIndex(const FName& Name)
+{
+	return FLocalNameTable::Get().CapturePropertyNames.IndexOfByKey(Name);
+}
+
 FName EAA::Internals::IndexToPinName(int32 Index, bool bIsInput)
 {
 	FLocalNameTable& Table = FLocalNameTable::Get();
@@ -18,6 +18,10 @@ namespace EAA::Switches
 	constexpr bool bEnableLatents = true;
 	// optimize generated graph by skipping literals and using pin values directly
 	constexpr bool bOptimizeSkipLiterals = true;
+	// create async action context and write its captures with single call instead of create, setup and set chain
+	constexpr bool bFusedContextCreate = true;
+	// find async action context and read its captures into event temporaries with single call
+	constexpr bool bFusedContextRead = true;
 }
 
 namespace EAA::Internals
@@ -35,6 +39,9 @@ namespace EAA::Internals
 	// Expose context pin on async action node
 	static const FName MD_ExposedAsyncContext = TEXT("ExposedAsyncContext");
 
+	// Action fires once, context is moved out on read and released right away
+	static const FName MD_ConsumeAsyncContext = TEXT("ConsumeAsyncContext");
+
 	// Marker to use enhanced latent node.
 	// Example: HasLatentContext=HandleParameter
 	static const FName MD_HasLatentContext = TEXT("HasLatentContext");
@@ -70,6 +77,8 @@ namespace EAA::Internals
 	UE_API FName IndexToName(int32 Index);
 
 	UE_API int32 NameToIndex(const FName& Name);
+	/** Find capture index of property name, INDEX_NONE if name is not a capture name */
+	UE_API int32 FindCaptureIndex(const FName& Name);
 
 	UE_API FName IndexToPinName(int32 Index, bool bIsInput);
 	UE_API int32 PinNameToIndex(const FName& Name, bool bIsInput);
@@ -28,6 +28,13 @@ bool FPropertyTypeInfo::IsSupported() const
 	return IsValid() && EAA::Internals::HasAccessorForType(*this);
 }
 
+bool FPropertyTypeInfo::IsMap() const
+{
+	return ContainerType == EPropertyBagContainerType::None
+		&& KeyType != EPropertyBagPropertyType::None
+		&& KeyType != EPropertyBagPropertyType::Count;
+}
+
 bool FPropertyTypeInfo::IsCompatibleWith(const FPropertyTypeInfo& Other) const
 {
 	// Containers must match
@@ -38,6 +45,10 @@ bool FPropertyTypeInfo::IsCompatibleWith(const FPropertyTypeInfo& Other) const
 	if (ValueType != Other.ValueType)
 		return false;
 
+	// Map keys must match exactly
+	if (KeyType != Other.KeyType || KeyTypeObject != Other.KeyTypeObject)
+		return false;
+
 	// Struct and enum must have same value type class
 	if (ValueType == EPropertyBagPropertyType::Enum || ValueType == EPropertyBagPropertyType::Struct)
 	{
@@ -56,10 +67,51 @@ bool FPropertyTypeInfo::IsCompatibleWith(const FPropertyTypeInfo& Other) const
 	return true;
 }
 
+static void AppendEncodedType(FStringBuilderBase& Builder, EPropertyBagPropertyType Type, const UObject* TypeObject)
+{
+	FString Str = StaticEnum<EPropertyBagPropertyType>()->GetNameByValue((int64)Type).ToString();
+	check(Str.StartsWith(EnumPrefix, ESearchCase::CaseSensitive));
+	Builder.Append(Str.RightChop(EnumPrefix.Len()));
+
+	if (::IsValid(TypeObject))
+	{
+		Builder.Append(TEXT("="));
+		Builder.Append(FSoftObjectPath(TypeObject).ToString());
+	}
+}
+
+static void ParseEncodedType(const FString& Data, EPropertyBagPropertyType& OutType, TObjectPtr<const UObject>& OutTypeObject)
+{
+	FString Type, Object;
+	if (Data.Split(TEXT("="), &Type, &Object))
+	{
+		int64 Value = StaticEnum<EPropertyBagPropertyType>()->GetValueByNameString( EnumPrefix + Type );
+		check (Value != INDEX_NONE);
+		OutType = static_cast<EPropertyBagPropertyType>(Value);
+		OutTypeObject = FSoftObjectPath(Object).ResolveObject();
+	}
+	else
+	{
+		int64 Value = StaticEnum<EPropertyBagPropertyType>()->GetValueByNameString( EnumPrefix + Data );
+		check (Value != INDEX_NONE);
+		OutType = static_cast<EPropertyBagPropertyType>(Value);
+	}
+}
+
 FString FPropertyTypeInfo::EncodeTypeInfo(const FPropertyTypeInfo& TypeInfo)
 {
 	FStringBuilderBase Builder;
 
+	if (TypeInfo.IsMap())
+	{
+		// M:Key>Value
+		Builder.Append(TEXT("M:"));
+		AppendEncodedType(Builder, TypeInfo.KeyType, TypeInfo.KeyTypeObject);
+		Builder.Append(TEXT(">"));
+		AppendEncodedType(Builder, TypeInfo.ValueType, TypeInfo.ValueTypeObject);
+		return Builder.ToString();
+	}
+
 	switch (TypeInfo.ContainerType)
 	{
 	default:
@@ -74,21 +126,9 @@ FString FPropertyTypeInfo::EncodeTypeInfo(const FPropertyTypeInfo& TypeInfo)
 	case EPropertyBagContainerType::Set:
 		Builder.Append(TEXT("S:"));
 		break;
-	// TODO: maps supported in 5.8
-	// case EPropertyBagContainerType::Map:
-		// Builder.Append(TEXT("M:"));
-		// break;
 	}
 
-	FString Str = StaticEnum<EPropertyBagPropertyType>()->GetNameByValue((int64)TypeInfo.ValueType).ToString();
-	check(Str.StartsWith(EnumPrefix, ESearchCase::CaseSensitive));
-	Builder.Append(Str.RightChop(EnumPrefix.Len()));
-
-	if (::IsValid(TypeInfo.ValueTypeObject))
-	{
-		Builder.Append(TEXT("="));
-		Builder.Append(FSoftObjectPath(TypeInfo.ValueTypeObject).ToString());
-	}
+	AppendEncodedType(Builder, TypeInfo.ValueType, TypeInfo.ValueTypeObject);
 
 	return Builder.ToString();
 }
@@ -114,25 +154,20 @@ bool FPropertyTypeInfo::ParseTypeInfo(FString Data, FPropertyTypeInfo& TypeInfo)
 		default: checkNoEntry(); break;
 		}
 
-		FString Type, Object;
-		if (Data.Split(TEXT("="), &Type, &Object))
-		{
-			int64 Value = StaticEnum<EPropertyBagPropertyType>()->GetValueByNameString( EnumPrefix + Type );
-			check (Value != INDEX_NONE);
-			TypeInfo.ValueType = static_cast<EPropertyBagPropertyType>(Value);
-			TypeInfo.ValueTypeObject = FSoftObjectPath(Object).ResolveObject();
-		}
-		else
-		{
-			int64 Value = StaticEnum<EPropertyBagPropertyType>()->GetValueByNameString( EnumPrefix + Data );
-			check (Value != INDEX_NONE);
-			TypeInfo.ValueType = static_cast<EPropertyBagPropertyType>(Value);
-		}
+		ParseEncodedType(Data, TypeInfo.ValueType, TypeInfo.ValueTypeObject);
 	}
 	else if (ContainerTypeKey == TEXT('M'))
 	{
-		// todo
-		return false;
+		FString Key, Value;
+		if (!Data.Split(TEXT(">"), &Key, &Value))
+		{
+			ensureAlwaysMsgf(false, TEXT("Bad map type format"));
+			return false;
+		}
+
+		TypeInfo.ContainerType = EPropertyBagContainerType::None;
+		ParseEncodedType(Key, TypeInfo.KeyType, TypeInfo.KeyTypeObject);
+		ParseEncodedType(Value, TypeInfo.ValueType, TypeInfo.ValueTypeObject);
 	}
 
 	return TypeInfo.IsValid();
@@ -158,6 +193,7 @@ FPropertyTypeInfo::FPropertyTypeInfo(const FProperty* ExistingProperty)
 	ContainerType = EAA::Internals::GetContainerTypeFromProperty(ExistingProperty);
 	if (auto AsMap = CastField<FMapProperty>(ExistingProperty))
 	{
+		ContainerType = EPropertyBagContainerType::None;
 		ValueType = EAA::Internals::GetValueTypeFromProperty(AsMap->ValueProp);
 		ValueTypeObject = EAA::Internals::GetValueTypeObjectFromProperty(AsMap->ValueProp);
 		KeyType = EAA::Internals::GetValueTypeFromProperty(AsMap->KeyProp);
@@ -225,7 +261,16 @@ bool EAA::Internals::SelectAccessorForType(const FPropertyTypeInfo& TypeInfo, EA
 		? GET_MEMBER_NAME_CHECKED(UEnhancedAsyncContextLibrary, Handle_SetValue_Generic)   \
 		: GET_MEMBER_NAME_CHECKED(UEnhancedAsyncContextLibrary, Handle_GetValue_Generic);
 
-	if (TypeInfo.ContainerType == EPropertyBagContainerType::None)
+	if (TypeInfo.IsMap())
+	{
+		FName TmpUnused;
+		if (SelectAccessorForType(FPropertyTypeInfo(TypeInfo.KeyType), Role, TmpUnused)
+			&& SelectAccessorForType(FPropertyTypeInfo(TypeInfo.ValueType), Role, TmpUnused))
+		{
+			FUNC_SELECT(Handle_SetValue_Map, Handle_GetValue_Map);
+		}
+	}
+	else if (TypeInfo.ContainerType == EPropertyBagContainerType::None)
 	{
 		switch(TypeInfo.ValueType)
 		{
@@ -314,7 +359,7 @@ EPropertyBagContainerType EAA::Internals::GetContainerTypeFromProperty(const FPr
 		return EPropertyBagContainerType::Set;
 	}
 	else if (CastField<FMapProperty>(InSourceProperty))
-	{ // todo: maps support in 5.8
+	{ // property bag has no map container, map captures are stored aside of it
 		return EPropertyBagContainerType::Count;
 	}
 
@@ -408,7 +453,7 @@ EPropertyBagPropertyType EAA::Internals::GetValueTypeFromProperty(const FPropert
 
 	// Handle map property
 	if (const FMapProperty* MapProperty = CastField<FMapProperty>(InSourceProperty))
-	{ // todo: maps support in 5.8
+	{ // map captures are not stored in property bag
 		return EPropertyBagPropertyType::Count;
 	}
 
@@ -461,7 +506,7 @@ UObject* EAA::Internals::GetValueTypeObjectFromProperty(const FProperty* InSourc
 
 	// Handle map property
 	if (const FMapProperty* MapProperty = CastField<FMapProperty>(InSourceProperty))
-	{ // todo: maps support in 5.8
+	{ // map captures are not stored in property bag
 		return nullptr;
 	}
 
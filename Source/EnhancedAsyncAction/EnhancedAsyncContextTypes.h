@@ -50,6 +50,8 @@ struct UE_API FPropertyTypeInfo
 	bool IsWildcard() const;
 	bool IsValid() const;
 	bool IsSupported() const;
+	// property bag has no map container, maps are described by key type
+	bool IsMap() const;
 
 	bool IsCompatibleWith(const FPropertyTypeInfo& Other) const;
 
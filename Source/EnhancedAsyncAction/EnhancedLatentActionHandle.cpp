@@ -6,17 +6,17 @@
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EnhancedLatentActionHandle)
 
 FEnhancedLatentActionContextHandle::FEnhancedLatentActionContextHandle()
-	: FAsyncContextHandleBase(FAsyncContextId(FAsyncContextId::InvalidValue)), CallInfo(FLatentCallInfo())
+	: FAsyncContextHandleBase(FAsyncContextId()), CallInfo(FLatentCallInfo())
 {
 }
 
 FEnhancedLatentActionContextHandle::FEnhancedLatentActionContextHandle(FLatentCallInfo InCallInfo)
-	: FAsyncContextHandleBase(FAsyncContextId(FAsyncContextId::InvalidValue)), CallInfo(InCallInfo)
+	: FAsyncContextHandleBase(FAsyncContextId()), CallInfo(InCallInfo)
 {
 }
 
-FEnhancedLatentActionContextHandle::FEnhancedLatentActionContextHandle(FAsyncContextId ContextId, FLatentCallInfo InCallInfo, TSharedRef<FEnhancedAsyncActionContext> Data)
-	: FAsyncContextHandleBase(ContextId, InCallInfo.OwningObject, Data), CallInfo(InCallInfo)
+FEnhancedLatentActionContextHandle::FEnhancedLatentActionContextHandle(FAsyncContextId ContextId, FLatentCallInfo InCallInfo)
+	: FAsyncContextHandleBase(ContextId, InCallInfo.OwningObject), CallInfo(InCallInfo)
 {
 }
 
@@ -34,8 +34,7 @@ void FEnhancedLatentActionContextHandle::ReleaseContextAndInvalidate()
 {
 	ReleaseContext();
 
-	ContextId = FAsyncContextId(FAsyncContextId::InvalidValue);
-	Data.Reset();
+	ContextId = FAsyncContextId();
 	Owner.Reset();
 }
 
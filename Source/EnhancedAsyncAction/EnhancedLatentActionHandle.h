@@ -5,7 +5,6 @@
 #include "UObject/Object.h"
 #include "UObject/Package.h"
 #include "LatentActions.h"
-#include "Templates/TypeHash.h"
 #include "EnhancedAsyncContextHandle.h"
 #include "EnhancedAsyncContextShared.h"
 #include "EnhancedLatentActionHandle.generated.h"
@@ -105,17 +104,6 @@ struct FLatentCallInfo
 	}
 };
 
-template <>
-inline FAsyncContextId FAsyncContextId::Make(const FLatentCallInfo& InResult)
-{
-	const uint32 Hash = ::PointerHash(InResult.OwningObject.Get(), ::HashCombine(InResult.UUID, InResult.CallID));
-#if WITH_CONTEXT_TYPE_TAG
-	return FAsyncContextId(Hash, FAsyncContextId::EContextType::CT_LatentAction);
-#else
-	return FAsyncContextId(Hash);
-#endif
-}
-
 /**
  * Latent call context handle that is passed around
  */
@@ -127,7 +115,7 @@ struct UE_API FEnhancedLatentActionContextHandle : public FAsyncContextHandleBas
 public:
 	FEnhancedLatentActionContextHandle();
 	FEnhancedLatentActionContextHandle(FLatentCallInfo CallInfo);
-	FEnhancedLatentActionContextHandle(FAsyncContextId ContextId, FLatentCallInfo CallInfo, TSharedRef<FEnhancedAsyncActionContext> Data);
+	FEnhancedLatentActionContextHandle(FAsyncContextId ContextId, FLatentCallInfo CallInfo);
 
 	/**
 	 * Is this handle considered valid?
@@ -138,7 +126,7 @@ public:
 
 	FString GetDebugString() const
 	{
-		return FString::Printf(TEXT("Id=%x %s"), (uint32)GetId(), *CallInfo.GetDebugString());
+		return FString::Printf(TEXT("Id=%s %s"), *GetId().ToString(), *CallInfo.GetDebugString());
 	}
 
 	/** Shortcut to resolve context from manager */
@@ -2,15 +2,37 @@
 
 #include "EnhancedAsyncActionEditorModule.h"
 #include "EnhancedAsyncContextCustomSettings.h"
+#include "EnhancedAsyncContextManager.h"
+#include "EnhancedAsyncContextSettings.h"
+#include "EnhancedAsyncContextShared.h"
+#include "K2Node_AsyncContextInterface.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "HAL/IConsoleManager.h"
 #include "PropertyEditorModule.h"
+#include "UObject/UObjectIterator.h"
 
 IMPLEMENT_MODULE(FEnhancedAsyncActionEditorModule, EnhancedAsyncActionEditor)
 
+static FAutoConsoleCommand GRecordWarmUpLayoutsCommand(
+	TEXT("EnhancedAsyncAction.RecordWarmUpLayouts"),
+	TEXT("Add capture layouts of enhanced nodes in loaded blueprints to warm-up list in project settings"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		TArray<FString> Definitions;
+		FEnhancedAsyncActionEditorModule::CollectContextLayouts(Definitions);
+		GetMutableDefault<UEnhancedAsyncContextSettings>()->AddWarmUpContextLayouts(Definitions);
+		UE_LOG(LogEnhancedAction, Display, TEXT("Recorded %d context layouts, %d in warm-up list"),
+			Definitions.Num(), UEnhancedAsyncContextSettings::Get()->GetWarmUpContextLayouts().Num());
+	})
+);
+
 void FEnhancedAsyncActionEditorModule::StartupModule()
 {
 	if (GIsEditor && !IsRunningCommandlet())
 	{
 		RegisterCustomSettings();
+		FEditorDelegates::PreBeginPIE.AddRaw(this, &FEnhancedAsyncActionEditorModule::OnPreBeginPIE);
 	}
 }
 
@@ -19,6 +41,39 @@ void FEnhancedAsyncActionEditorModule::ShutdownModule()
 	if (GIsEditor && !IsRunningCommandlet())
 	{
 		UnRegisterCustomSettings();
+		FEditorDelegates::PreBeginPIE.RemoveAll(this);
+	}
+}
+
+void FEnhancedAsyncActionEditorModule::CollectContextLayouts(TArray<FString>& OutDefinitions)
+{
+	for (TObjectIterator<UK2Node> It; It; ++It)
+	{
+		const UK2Node* Node = *It;
+		const IK2Node_AsyncContextInterface* ContextNode = Cast<IK2Node_AsyncContextInterface>(Node);
+		if (!ContextNode || Node->IsTemplate() || !Node->GetTypedOuter<UBlueprint>() || ContextNode->GetNumCaptures() == 0)
+		{
+			continue;
+		}
+
+		const FString Definition = ContextNode->BuildContextConfigString();
+		if (!Definition.IsEmpty())
+		{
+			OutDefinitions.AddUnique(Definition);
+		}
+	}
+}
+
+void FEnhancedAsyncActionEditorModule::OnPreBeginPIE(bool bIsSimulating)
+{
+	// blueprints edited in this session may not be listed in project settings yet
+	TArray<FString> Definitions;
+	CollectContextLayouts(Definitions);
+
+	FEnhancedAsyncContextPool& Pool = FEnhancedAsyncContextManager::Get().GetContextPool();
+	for (const FString& Definition : Definitions)
+	{
+		Pool.WarmUpLayout(Definition);
 	}
 }
 
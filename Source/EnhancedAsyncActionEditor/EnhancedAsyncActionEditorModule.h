@@ -10,7 +10,12 @@ public:
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
 
+	/** Collect capture config strings of enhanced nodes in loaded blueprints */
+	static void CollectContextLayouts(TArray<FString>& OutDefinitions);
+
 private:
 	void RegisterCustomSettings();
 	void UnRegisterCustomSettings();
+
+	void OnPreBeginPIE(bool bIsSimulating);
 };
@@ -125,7 +125,8 @@ FPropertyTypeInfo EAA::Internals::IdentifyPropertyTypeForPin(const FEdGraphPinTy
 	}
 	else if (ContainerType == EPinContainerType::Map)
 	{
-		return FPropertyTypeInfo::Invalid;
+		// maps are described by key type
+		TypeInfo.ContainerType = EPropertyBagContainerType::None;
 	}
 	else
 	{
@@ -243,8 +244,8 @@ FPropertyTypeInfo EAA::Internals::IdentifyPropertyTypeForPin(const FEdGraphPinTy
 	}
 	else
 	{
-		// todo: maps
-		ensureAlways(false);
+		GuessType(Type, TypeInfo.KeyType, TypeInfo.KeyTypeObject);
+		GuessType(FEdGraphPinType::GetPinTypeForTerminalType(Type.PinValueType), TypeInfo.ValueType, TypeInfo.ValueTypeObject);
 	}
 
 	return TypeInfo;
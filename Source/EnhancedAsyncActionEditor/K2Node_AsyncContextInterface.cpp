@@ -1,6 +1,7 @@
 ﻿// Copyright 2025, Aquanox.
 
 #include "K2Node_AsyncContextInterface.h"
+#include "K2Node_EnhancedAsyncTaskBase.h"
 #include "EnhancedAsyncContextShared.h"
 #include "EnhancedAsyncContextPrivate.h"
 #include "EdGraph/EdGraphPin.h"
@@ -343,6 +344,8 @@ FString IK2Node_AsyncContextInterface::BuildContextConfigString() const
 {
 	FStringBuilderBase BuilderBase;
 
+	const bool bAllowConstantCaptures = AllowsConstantCaptures();
+
 	ForEachCapturePinPair([&](int32 Index, UEdGraphPin* InPin, UEdGraphPin* OutPin)
 	{
 		FEdGraphPinType DetectedPinType = EAA::Internals::DetermineCommonPinType(InPin, OutPin);
@@ -350,6 +353,13 @@ FString IK2Node_AsyncContextInterface::BuildContextConfigString() const
 		if (BuilderBase.Len())
 			BuilderBase.Append(TEXT(";"));
 
+		// constant captures are assigned as literals and keep no slot in context layout
+		if (bAllowConstantCaptures && !EAA::Internals::IsWildcardType(InPin->PinType) && UK2Node_EnhancedAsyncTaskBase::FindConstantCaptureSource(InPin))
+		{
+			BuilderBase.Append(FPropertyTypeInfo::EncodeTypeInfo(FPropertyTypeInfo::Wildcard));
+			return true;
+		}
+
 		FPropertyTypeInfo TypeInfo = EAA::Internals::IdentifyPropertyTypeForPin(DetectedPinType);
 		ensureAlways(TypeInfo.IsValid());
 		BuilderBase.Append(FPropertyTypeInfo::EncodeTypeInfo(TypeInfo));
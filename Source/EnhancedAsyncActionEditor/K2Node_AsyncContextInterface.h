@@ -91,6 +91,11 @@ public:
 	 */
 	virtual TArray<FEnhancedAsyncTaskCapture>& GetMutableCapturesArray() = 0;
 
+	/**
+	 * Can capture inputs known at compile time be assigned as literals instead of being stored in context
+	 */
+	virtual bool AllowsConstantCaptures() const { return false; }
+
 	virtual bool CanAddPin() const override;
 	virtual void AddInputPin() override;
 	virtual bool CanRemovePin(const UEdGraphPin* Pin) const override;
@@ -13,6 +13,7 @@
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "KismetCompiler.h"
 #include "ScopedTransaction.h"
+#include "UObject/StructOnScope.h"
 #include "EnhancedAsyncContextShared.h"
 #include "K2Node_AddDelegate.h"
 #include "K2Node_AssignmentStatement.h"
@@ -20,13 +21,25 @@
 #include "EnhancedAsyncContextPrivate.h"
 #include "EnhancedAsyncContextSettings.h"
 #include "K2Node_CallArrayFunction.h"
-#include "K2Node_MakeArray.h"
 #include "ToolMenu.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(K2Node_EnhancedAsyncTaskBase)
 
 #define LOCTEXT_NAMESPACE "UK2Node_EnhancedAsyncTaskBase"
 
+// Bit mask of capture indices consumed by indexed variadic accessors
+template<typename TPinInfo>
+static int32 MakeCaptureMask(const TArray<TPinInfo>& Captures)
+{
+	uint32 Mask = 0;
+	for (const TPinInfo& Info : Captures)
+	{
+		check(Info.CaptureIndex >= 0 && Info.CaptureIndex < EAA::Internals::MaxCapturePins);
+		Mask |= 1u << Info.CaptureIndex;
+	}
+	return static_cast<int32>(Mask);
+}
+
 UK2Node_EnhancedAsyncTaskBase::UK2Node_EnhancedAsyncTaskBase()
 {
 }
@@ -104,12 +117,14 @@ void UK2Node_EnhancedAsyncTaskBase::ImportConfigFromClass(UClass* InClass)
 	}
 
 	bExposeContextParameter = EAA::Internals::FindMetadataHierarchical(InClass, EAA::Internals::MD_ExposedAsyncContext) != nullptr;
+	bConsumeContextOnRead = EAA::Internals::FindMetadataHierarchical(InClass, EAA::Internals::MD_ConsumeAsyncContext) != nullptr;
 }
 
 void UK2Node_EnhancedAsyncTaskBase::ImportConfigFromSpec(UClass* InClass, const FExternalAsyncActionSpec& InSpec)
 {
 	AsyncContextParameterName = InSpec.ContextPropertyName;
 	bExposeContextParameter = InSpec.bExposedContext;
+	bConsumeContextOnRead = InSpec.bConsumeContextOnRead;
 
 	if (!InSpec.ContainerPropertyName.IsNone() && EAA::Internals::IsValidContainerProperty(InClass, InSpec.ContainerPropertyName))
 	{
@@ -387,7 +402,8 @@ bool UK2Node_EnhancedAsyncTaskBase::HandleSetupContext(
 
 bool UK2Node_EnhancedAsyncTaskBase::HandleSetContextData(
 	const TArray<FInputPinInfo>& CaptureInputs, UEdGraphPin* InContextHandlePin, UEdGraphPin*& InOutLastThenPin,
-	UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+	UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph,
+	bool bContextSetUp)
 {
 	if (CaptureInputs.Num() == 0)
 	{ // there are no capture inputs. can safely skip
@@ -395,6 +411,36 @@ bool UK2Node_EnhancedAsyncTaskBase::HandleSetContextData(
 	}
 
 	bool bIsErrorFree = true;
+
+	// Captures not declared by setup are collected and declared with a single layout build
+	auto AddStagingCall = [&](FName FunctionName)
+	{
+		UK2Node_CallFunction* const CallStagingNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(Self, SourceGraph);
+		CallStagingNode->FunctionReference.SetExternalMember(FunctionName, UEnhancedAsyncContextLibrary::StaticClass());
+		CallStagingNode->AllocateDefaultPins();
+
+		UEdGraphPin* HandlePin = CallStagingNode->FindPinChecked(EAA::Internals::PIN_Handle);
+		if (!Schema->CanCreateConnection(InContextHandlePin, HandlePin).CanSafeConnect())
+		{
+			bIsErrorFree &= Schema->CreateAutomaticConversionNodeAndConnections(InContextHandlePin, HandlePin);
+		}
+		else
+		{
+			bIsErrorFree &= Schema->TryCreateConnection(InContextHandlePin, HandlePin);
+		}
+		CallStagingNode->NotifyPinConnectionListChanged(HandlePin);
+
+		bIsErrorFree &= Schema->TryCreateConnection(InOutLastThenPin, CallStagingNode->GetExecPin());
+		InOutLastThenPin = CallStagingNode->GetThenPin();
+	};
+
+	// setup call already locked the layout, staging would not batch anything
+	const bool bUseStaging = !bContextSetUp && CaptureInputs.Num() > 1;
+	if (bUseStaging)
+	{
+		AddStagingCall(GET_MEMBER_NAME_CHECKED(UEnhancedAsyncContextLibrary, BeginContextStaging));
+	}
+
 	for (const FInputPinInfo& Info : CaptureInputs)
 	{
 		UEdGraphPin* const InputPin = Info.InputPin;
@@ -465,6 +511,11 @@ bool UK2Node_EnhancedAsyncTaskBase::HandleSetContextData(
 		InOutLastThenPin = CallNode->GetThenPin();
 	}
 
+	if (bUseStaging)
+	{
+		AddStagingCall(GET_MEMBER_NAME_CHECKED(UEnhancedAsyncContextLibrary, CommitContextStaging));
+	}
+
 	return bIsErrorFree;
 }
 
@@ -474,61 +525,61 @@ bool UK2Node_EnhancedAsyncTaskBase::HandleSetContextDataVariadic(
 {
 	bool bIsErrorFree = true;
 
-	// Create a "Make Array" node to compile the list of arguments into an array
-	UK2Node_MakeArray* MakeArrayNode = CompilerContext.SpawnIntermediateNode<UK2Node_MakeArray>(Self, SourceGraph);
-	MakeArrayNode->NumInputs = CaptureInputs.Num();
-	MakeArrayNode->AllocateDefaultPins();
-
-	// Create Call "Set Context Variadic"
+	// Create Call "Set Context Indexed"
 	UK2Node_CallFunction* CallSetVariadic = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(Self, SourceGraph);
 	CallSetVariadic->FunctionReference.SetExternalMember(
-		GET_MEMBER_NAME_CHECKED(UEnhancedAsyncContextLibrary, Handle_SetValue_Variadic),
+		GET_MEMBER_NAME_CHECKED(UEnhancedAsyncContextLibrary, Handle_SetValue_Indexed),
 		UEnhancedAsyncContextLibrary::StaticClass()
 	);
 	CallSetVariadic->AllocateDefaultPins();
 
-	// Set the names parameter and force the MakeArray pin type deduction
-	UEdGraphPin* ArrayOut = MakeArrayNode->GetOutputPin();
-	bIsErrorFree &= Schema->TryCreateConnection(ArrayOut, CallSetVariadic->FindPinChecked(TEXT("Names")));
-	MakeArrayNode->PinConnectionListChanged(ArrayOut);
+	bIsErrorFree &= HandleVariadicCaptureInputs(CaptureInputs, CallSetVariadic, Self, Schema, CompilerContext, SourceGraph);
 
-	int32 ArrayInputIndex = 0;
-	for (const FInputPinInfo& Info : CaptureInputs)
+	// Set the handle parameter
+	UEdGraphPin* HandlePin = CallSetVariadic->FindPinChecked(EAA::Internals::PIN_Handle);
+	if (!Schema->CanCreateConnection(InContextHandlePin, HandlePin).CanSafeConnect())
+	{
+		bIsErrorFree &= Schema->CreateAutomaticConversionNodeAndConnections(InContextHandlePin, HandlePin);
+	}
+	else
+	{
+		bIsErrorFree &= Schema->TryCreateConnection(InContextHandlePin, HandlePin);
+	}
+	CallSetVariadic->PinConnectionListChanged(HandlePin);
+
+	// Connect execs
+	bIsErrorFree &= Schema->TryCreateConnection(InOutLastThenPin, CallSetVariadic->GetExecPin());
+	InOutLastThenPin = CallSetVariadic->GetThenPin();
+
+	return bIsErrorFree;
+}
+
+bool UK2Node_EnhancedAsyncTaskBase::HandleVariadicCaptureInputs(
+	const TArray<FInputPinInfo>& CaptureInputs, UK2Node_CallFunction* CallNode,
+	UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	bool bIsErrorFree = true;
+
+	// Variadic values are read in ascending capture index order
+	TArray<FInputPinInfo> SortedInputs = CaptureInputs;
+	SortedInputs.Sort([](const FInputPinInfo& A, const FInputPinInfo& B) { return A.CaptureIndex < B.CaptureIndex; });
+
+	// Bake the capture indices into single literal
+	Schema->TrySetDefaultValue(*CallNode->FindPinChecked(TEXT("Captures")), FString::FromInt(MakeCaptureMask(SortedInputs)));
+
+	for (const FInputPinInfo& Info : SortedInputs)
 	{
 		const FName VariadicPropertyName = EAA::Internals::IndexToName(Info.CaptureIndex);
 
 		UEdGraphPin* const InputPin = Info.InputPin;
 		check(InputPin->Direction == EGPD_Input);
 
-		// Find the input pin on the "Make Array" node by index and set value
-		UEdGraphPin* ArrayIn = MakeArrayNode->FindPinChecked(MakeArrayNode->GetPinName(ArrayInputIndex++));
-		if (!EAA::Switches::bOptimizeSkipLiterals)
-		{
-			// Create the "Make Literal String" node
-			UK2Node_CallFunction* MakeLiteralStringNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(Self, SourceGraph);
-			MakeLiteralStringNode->FunctionReference.SetExternalMember(
-				GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, MakeLiteralString),
-				UKismetSystemLibrary::StaticClass()
-			);
-			MakeLiteralStringNode->AllocateDefaultPins();
-
-			// Set the literal value to the capture parameter name
-			UEdGraphPin* MakeLiteralStringValuePin = MakeLiteralStringNode->FindPinChecked(TEXT("Value"), EGPD_Input);
-			Schema->TrySetDefaultValue(*MakeLiteralStringValuePin, VariadicPropertyName.ToString());
-
-			bIsErrorFree &= Schema->TryCreateConnection(MakeLiteralStringNode->GetReturnValuePin(), ArrayIn);
-		}
-		else
-		{
-			Schema->TrySetDefaultValue(*ArrayIn, VariadicPropertyName.ToString());
-		}
-
 		FEdGraphPinType PinType = InputPin->PinType;
 		PinType.bIsReference = true;
 		PinType.bIsConst = true;
 
 		// Create variadic pin on setter function
-		UEdGraphPin* ValuePin = CallSetVariadic->CreatePin(EGPD_Input, PinType, VariadicPropertyName);
+		UEdGraphPin* ValuePin = CallNode->CreatePin(EGPD_Input, PinType, VariadicPropertyName);
 
 		if (!InputPin->LinkedTo.Num())
 		{ // create a dummy local input
@@ -539,30 +590,14 @@ bool UK2Node_EnhancedAsyncTaskBase::HandleSetContextDataVariadic(
 			bIsErrorFree &= CompilerContext.MovePinLinksToIntermediate(*InputPin, *ValuePin).CanSafeConnect();
 		}
 
-		CallSetVariadic->PinConnectionListChanged(ValuePin);
-	}
-
-	// Set the handle parameter
-	UEdGraphPin* HandlePin = CallSetVariadic->FindPinChecked(EAA::Internals::PIN_Handle);
-	if (!Schema->CanCreateConnection(InContextHandlePin, HandlePin).CanSafeConnect())
-	{
-		bIsErrorFree &= Schema->CreateAutomaticConversionNodeAndConnections(InContextHandlePin, HandlePin);
+		CallNode->PinConnectionListChanged(ValuePin);
 	}
-	else
-	{
-		bIsErrorFree &= Schema->TryCreateConnection(InContextHandlePin, HandlePin);
-	}
-	CallSetVariadic->PinConnectionListChanged(HandlePin);
-
-	// Connect execs
-	bIsErrorFree &= Schema->TryCreateConnection(InOutLastThenPin, CallSetVariadic->GetExecPin());
-	InOutLastThenPin = CallSetVariadic->GetThenPin();
 
 	return bIsErrorFree;
 }
 
 bool UK2Node_EnhancedAsyncTaskBase::HandleActionDelegates(
-	UK2Node_CallFunction* CallCreateProxyObjectNode, UEdGraphPin*& InOutLastThenPin,
+	UK2Node_CallFunction* CallCreateProxyObjectNode, UEdGraphPin*& InOutLastThenPin, const TMap<int32, UEdGraphPin*>& ConstantCaptures,
 	const UEdGraphSchema_K2* Schema, UEdGraph* SourceGraph, FKismetCompilerContext& CompilerContext)
 {
 	UEdGraphPin* const OutputAsyncTaskProxy = FindPin(FBaseAsyncTaskHelper::GetAsyncTaskProxyName());
@@ -628,6 +663,7 @@ bool UK2Node_EnhancedAsyncTaskBase::HandleActionDelegates(
 				Info.CaptureIndex = Index;
 				Info.OutputPin = CurrentPin;
 				Info.TempVar = TempVarOutput;
+				Info.ConstantSource = ConstantCaptures.FindRef(Index);
 			}
 			return true;
 		});
@@ -650,7 +686,7 @@ bool UK2Node_EnhancedAsyncTaskBase::HandleActionDelegates(
 		/// ==================
 		///  [Node] - [Add Delegate]
 		///             |
-		///  [CustomEvent] - [FindCaptureContextForObject] - [ assign context vars ] - [ assign event vars ]
+		///  [CustomEvent] - [Action_GetValue_Indexed] - [ assign event vars ]
 		/// ==================
 
 		// Create custom event node matching the signature
@@ -673,42 +709,45 @@ bool UK2Node_EnhancedAsyncTaskBase::HandleActionDelegates(
 
 		OutLastActivatedThenPin = CurrentCENode->FindPinChecked(UEdGraphSchema_K2::PN_Then);
 
-		UEdGraphPin* ContextHandlePin = nullptr;
+		UEdGraphPin* PinWithData = CurrentCENode->FindPin(AsyncContextParameterName);
+		if (PinWithData == nullptr)
+		{
+			FText ErrorMessage = FText::Format(
+				LOCTEXT("MissingContextPin", "EnhancedAsyncTaskBase: Node @@ was expecting a data output pin named {0} on @@ (each delegate must have the same signature)"),
+				FText::FromName(AsyncContextParameterName));
+			CompilerContext.MessageLog.Error(*ErrorMessage.ToString(), this, CurrentCENode);
+			return false;
+		}
 
-		// Create context loader
+		if (EAA::Switches::bFusedContextRead && EAA::Switches::bVariadicGetSet)
+		{ // find context and read captures with single call
+			bIsErrorFree &= HandleGetActionCapturesIndexed(CaptureOutputs, PinWithData, OutLastActivatedThenPin, this, Schema, CompilerContext, SourceGraph, bConsumeContextOnRead);
+		}
+		else
 		{
+			// Create context loader
 			UK2Node_CallFunction* const CallGetCtx = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
 			CallGetCtx->FunctionReference.SetExternalMember(
 				GET_MEMBER_NAME_CHECKED(UEnhancedAsyncContextLibrary, FindCaptureContextForObject),
 				UEnhancedAsyncContextLibrary::StaticClass());
 			CallGetCtx->AllocateDefaultPins();
 
-			UEdGraphPin* PinWithData = CurrentCENode->FindPin(AsyncContextParameterName);
-			if (PinWithData == nullptr)
-			{
-				FText ErrorMessage = FText::Format(
-					LOCTEXT("MissingContextPin", "EnhancedAsyncTaskBase: Node @@ was expecting a data output pin named {0} on @@ (each delegate must have the same signature)"),
-					FText::FromName(AsyncContextParameterName));
-				CompilerContext.MessageLog.Error(*ErrorMessage.ToString(), this, CurrentCENode);
-				return false;
-			}
-
-			ContextHandlePin = CallGetCtx->FindPinChecked(EAA::Internals::PIN_Handle);
+			UEdGraphPin* const ContextHandlePin = CallGetCtx->FindPinChecked(EAA::Internals::PIN_Handle);
 
 			bIsErrorFree &= Schema->TryCreateConnection(PinWithData, CallGetCtx->FindPinChecked(EAA::Internals::PIN_Action));
 
 			bIsErrorFree &= Schema->TryCreateConnection(OutLastActivatedThenPin, CallGetCtx->GetExecPin());
 			OutLastActivatedThenPin = CallGetCtx->GetThenPin();
-		}
 
-		// CREATE CONTEXT GETTERS
-		if (EAA::Switches::bVariadicGetSet)
-		{
-			bIsErrorFree &= HandleGetContextDataVariadic(CaptureOutputs, ContextHandlePin, OutLastActivatedThenPin, this, Schema, CompilerContext, SourceGraph);
-		}
-		else
-		{
-			bIsErrorFree &= HandleGetContextData(CaptureOutputs, ContextHandlePin, OutLastActivatedThenPin, this, Schema, CompilerContext, SourceGraph);
+			// CREATE CONTEXT GETTERS
+			if (EAA::Switches::bVariadicGetSet)
+			{
+				bIsErrorFree &= HandleGetContextDataVariadic(CaptureOutputs, ContextHandlePin, OutLastActivatedThenPin, this, Schema, CompilerContext, SourceGraph, bConsumeContextOnRead);
+			}
+			else
+			{
+				bIsErrorFree &= HandleGetContextData(CaptureOutputs, ContextHandlePin, OutLastActivatedThenPin, this, Schema, CompilerContext, SourceGraph);
+			}
 		}
 		ensureAlwaysMsgf(bIsErrorFree, TEXT("node failed to build"));
 
@@ -741,12 +780,119 @@ bool UK2Node_EnhancedAsyncTaskBase::HandleActionDelegates(
 	return bIsErrorFree;
 }
 
+UEdGraphPin* UK2Node_EnhancedAsyncTaskBase::FindConstantCaptureSource(UEdGraphPin* InputPin)
+{
+	if (!InputPin || InputPin->PinType.IsContainer() || InputPin->PinType.bIsReference)
+	{
+		return nullptr;
+	}
+
+	if (InputPin->LinkedTo.Num() == 0)
+	{
+		return InputPin;
+	}
+
+	// value produced by a pure literal node is known at compile time as well
+	UEdGraphPin* const SourcePin = InputPin->LinkedTo.Num() == 1 ? InputPin->LinkedTo[0] : nullptr;
+	const UK2Node_CallFunction* const LiteralNode = SourcePin ? Cast<UK2Node_CallFunction>(SourcePin->GetOwningNode()) : nullptr;
+	const UFunction* const Function = LiteralNode ? LiteralNode->GetTargetFunction() : nullptr;
+	static const FName LiteralFunctions[] = {
+		GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, MakeLiteralInt),
+		GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, MakeLiteralInt64),
+		GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, MakeLiteralDouble),
+		GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, MakeLiteralBool),
+		GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, MakeLiteralName),
+		GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, MakeLiteralByte),
+		GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, MakeLiteralString),
+		GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, MakeLiteralText),
+	};
+	if (!Function || Function->GetOwnerClass() != UKismetSystemLibrary::StaticClass() || !MakeArrayView(LiteralFunctions).Contains(Function->GetFName()))
+	{
+		return nullptr;
+	}
+
+	UEdGraphPin* const ValuePin = LiteralNode->FindPin(TEXT("Value"), EGPD_Input);
+	if (!ValuePin || ValuePin->LinkedTo.Num() != 0 || SourcePin->PinType != InputPin->PinType)
+	{
+		return nullptr;
+	}
+	return ValuePin;
+}
+
+FString UK2Node_EnhancedAsyncTaskBase::GetConstantCaptureDefaultValue(const FEdGraphPinType& PinType, const FString& DefaultValue)
+{
+	const UScriptStruct* Struct = Cast<UScriptStruct>(PinType.PinSubCategoryObject.Get());
+	if (!DefaultValue.IsEmpty() || PinType.PinCategory != UEdGraphSchema_K2::PC_Struct || !Struct)
+	{
+		return DefaultValue;
+	}
+
+	// empty default of unlinked struct pin stands for default constructed struct
+	FStructOnScope StructDefault(Struct);
+	FString Result;
+	Struct->ExportText(Result, StructDefault.GetStructMemory(), nullptr, nullptr, PPF_None, nullptr);
+	return Result;
+}
+
+bool UK2Node_EnhancedAsyncTaskBase::HandleConstantCaptures(
+	const TArray<FOutputPinInfo>& CaptureOutputs, TArray<FOutputPinInfo>& OutContextOutputs, UEdGraphPin*& InOutLastThenPin,
+	UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	bool bIsErrorFree = true;
+
+	for (const FOutputPinInfo& OutputPair : CaptureOutputs)
+	{
+		if (!OutputPair.ConstantSource)
+		{
+			OutContextOutputs.Add(OutputPair);
+			continue;
+		}
+
+		// [temp var]  - [assign]
+		// [literal]   - [value ]
+		UEdGraphPin* VariablePin = nullptr;
+		if (OutputPair.TempVar)
+		{
+			VariablePin = OutputPair.TempVar->GetVariablePin();
+		}
+		else
+		{
+			const FEdGraphPinType& PinType = OutputPair.OutputPin->PinType;
+			UK2Node_TemporaryVariable* TempVarOutput = CompilerContext.SpawnInternalVariable(Self, PinType.PinCategory, PinType.PinSubCategory, PinType.PinSubCategoryObject.Get(), PinType.ContainerType, PinType.PinValueType);
+			VariablePin = TempVarOutput->GetVariablePin();
+			bIsErrorFree &= VariablePin && CompilerContext.MovePinLinksToIntermediate(*OutputPair.OutputPin, *VariablePin).CanSafeConnect();
+		}
+
+		UK2Node_AssignmentStatement* AssignNode = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(Self, SourceGraph);
+		AssignNode->AllocateDefaultPins();
+
+		// value
+		bIsErrorFree &= Schema->TryCreateConnection(VariablePin, AssignNode->GetVariablePin());
+		AssignNode->NotifyPinConnectionListChanged(AssignNode->GetVariablePin());
+
+		// literal is compiled into the graph once, nothing is written to context per call
+		UEdGraphPin* ValuePin = AssignNode->GetValuePin();
+		ValuePin->DefaultValue = GetConstantCaptureDefaultValue(OutputPair.ConstantSource->PinType, OutputPair.ConstantSource->DefaultValue);
+		ValuePin->DefaultObject = OutputPair.ConstantSource->DefaultObject;
+		ValuePin->DefaultTextValue = OutputPair.ConstantSource->DefaultTextValue;
+
+		// exec
+		bIsErrorFree &= Schema->TryCreateConnection(InOutLastThenPin, AssignNode->GetExecPin());
+		InOutLastThenPin = AssignNode->GetThenPin();
+	}
+
+	return bIsErrorFree;
+}
+
 bool UK2Node_EnhancedAsyncTaskBase::HandleGetContextData(
-	const TArray<FOutputPinInfo>& CaptureOutputs, UEdGraphPin* ContextHandlePin, UEdGraphPin*& InOutLastThenPin,
+	const TArray<FOutputPinInfo>& InCaptureOutputs, UEdGraphPin* ContextHandlePin, UEdGraphPin*& InOutLastThenPin,
 	UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
 {
 	bool bIsErrorFree = true;
 
+	TArray<FOutputPinInfo> CaptureOutputs;
+	bIsErrorFree &= HandleConstantCaptures(InCaptureOutputs, CaptureOutputs, InOutLastThenPin, Self, Schema, CompilerContext, SourceGraph);
+
 	for (const FOutputPinInfo& OutputPair : CaptureOutputs)
 	{
 		// [temp var]      - [assign]
@@ -818,63 +964,34 @@ bool UK2Node_EnhancedAsyncTaskBase::HandleGetContextData(
 }
 
 bool UK2Node_EnhancedAsyncTaskBase::HandleGetContextDataVariadic(
-	const TArray<FOutputPinInfo>& CaptureOutputs, UEdGraphPin* ContextHandlePin, UEdGraphPin*& InOutLastThenPin,
-	UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+	const TArray<FOutputPinInfo>& InCaptureOutputs, UEdGraphPin* ContextHandlePin, UEdGraphPin*& InOutLastThenPin,
+	UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph,
+	bool bConsume)
 {
 	bool bIsErrorFree = true;
 
+	TArray<FOutputPinInfo> CaptureOutputs;
+	bIsErrorFree &= HandleConstantCaptures(InCaptureOutputs, CaptureOutputs, InOutLastThenPin, Self, Schema, CompilerContext, SourceGraph);
+
 	if (CaptureOutputs.Num() == 0)
 	{ // there are no outputs, can safely skip
-		return true;
+		return bIsErrorFree;
 	}
 
-	// Create a "Make Array" node to compile the list of arguments into an array
-	UK2Node_MakeArray* MakeArrayNode = CompilerContext.SpawnIntermediateNode<UK2Node_MakeArray>(Self, SourceGraph);
-	MakeArrayNode->NumInputs = CaptureOutputs.Num();
-	MakeArrayNode->AllocateDefaultPins();
+	// Variadic values are written in ascending capture index order
+	CaptureOutputs.Sort([](const FOutputPinInfo& A, const FOutputPinInfo& B) { return A.CaptureIndex < B.CaptureIndex; });
 
-	//
 	auto CallGetVariadic = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(Self, SourceGraph);
 	CallGetVariadic->FunctionReference.SetExternalMember(
-		GET_MEMBER_NAME_CHECKED(UEnhancedAsyncContextLibrary, Handle_GetValue_Variadic),
+		bConsume
+			? GET_MEMBER_NAME_CHECKED(UEnhancedAsyncContextLibrary, Handle_ConsumeValue_Indexed)
+			: GET_MEMBER_NAME_CHECKED(UEnhancedAsyncContextLibrary, Handle_GetValue_Indexed),
 		UEnhancedAsyncContextLibrary::StaticClass()
 	);
 	CallGetVariadic->AllocateDefaultPins();
 
-	// Set the names parameter and force the MakeArray pin type deduction
-	UEdGraphPin* ArrayOut = MakeArrayNode->GetOutputPin();
-	bIsErrorFree &= Schema->TryCreateConnection(ArrayOut, CallGetVariadic->FindPinChecked(TEXT("Names")));
-	MakeArrayNode->PinConnectionListChanged(ArrayOut);
-
-	int32 ArrayInputIndex = 0;
-	for (const FOutputPinInfo& OutputPair : CaptureOutputs)
-	{
-		const FName VariadicPropertyName = EAA::Internals::IndexToName(OutputPair.CaptureIndex);
-
-		// Find the input pin on the "Make Array" node by index and link it to the literal string
-		UEdGraphPin* ArrayIn = MakeArrayNode->FindPinChecked(MakeArrayNode->GetPinName(ArrayInputIndex++));
-
-		if (!EAA::Switches::bOptimizeSkipLiterals)
-		{
-			// Create the "Make Literal String" node
-			UK2Node_CallFunction* MakeLiteralStringNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(Self, SourceGraph);
-			MakeLiteralStringNode->FunctionReference.SetExternalMember(
-				GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, MakeLiteralString),
-				UKismetSystemLibrary::StaticClass()
-			);
-			MakeLiteralStringNode->AllocateDefaultPins();
-
-			// Set the literal value to the capture parameter name
-			UEdGraphPin* MakeLiteralStringValuePin = MakeLiteralStringNode->FindPinChecked(TEXT("Value"), EGPD_Input);
-			Schema->TrySetDefaultValue(*MakeLiteralStringValuePin, VariadicPropertyName.ToString());
-
-			bIsErrorFree &= Schema->TryCreateConnection(MakeLiteralStringNode->GetReturnValuePin(), ArrayIn);
-		}
-		else
-		{
-			Schema->TrySetDefaultValue(*ArrayIn, VariadicPropertyName.ToString());
-		}
-	}
+	// Bake the capture indices into single literal
+	Schema->TrySetDefaultValue(*CallGetVariadic->FindPinChecked(TEXT("Captures")), FString::FromInt(MakeCaptureMask(CaptureOutputs)));
 
 	// Set the handle parameter
 	UEdGraphPin* HandlePin = CallGetVariadic->FindPinChecked(EAA::Internals::PIN_Handle);
@@ -893,38 +1010,71 @@ bool UK2Node_EnhancedAsyncTaskBase::HandleGetContextDataVariadic(
 
 	for (const FOutputPinInfo& OutputPair : CaptureOutputs)
 	{
-		const FName VariadicPropertyName = EAA::Internals::IndexToName(OutputPair.CaptureIndex);
+		bIsErrorFree &= CreateCaptureReadPin(CallGetVariadic, OutputPair, Schema, CompilerContext);
+	}
 
-		FEdGraphPinType PinType = OutputPair.OutputPin->PinType;
-		// PinType.bIsReference = true;
-		// PinType.bIsConst = false;
+	return bIsErrorFree;
+}
 
-		// create variadic pin
-		UEdGraphPin* const ValuePin = CallGetVariadic->CreatePin(EGPD_Output, PinType, VariadicPropertyName);
+bool UK2Node_EnhancedAsyncTaskBase::CreateCaptureReadPin(
+	UK2Node_CallFunction* CallNode, const FOutputPinInfo& OutputPair,
+	const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext)
+{
+	const FName VariadicPropertyName = EAA::Internals::IndexToName(OutputPair.CaptureIndex);
 
-		if (OutputPair.TempVar)
-		{
-			// make assignment node to the hidden temp variable
-			UK2Node_AssignmentStatement* AssignNode = CompilerContext.SpawnIntermediateNode<UK2Node_AssignmentStatement>(Self, SourceGraph);
-			AssignNode->AllocateDefaultPins();
+	FEdGraphPinType PinType = OutputPair.OutputPin->PinType;
 
-			// value
-			bIsErrorFree &= Schema->TryCreateConnection(OutputPair.TempVar->GetVariablePin(), AssignNode->GetVariablePin());
-			AssignNode->NotifyPinConnectionListChanged(AssignNode->GetVariablePin());
+	if (OutputPair.TempVar)
+	{
+		// context writes into the hidden temp variable directly, no assignment statement
+		PinType.bIsReference = true;
+		UEdGraphPin* const RefPin = CallNode->CreatePin(EGPD_Input, PinType, VariadicPropertyName);
+		return Schema->TryCreateConnection(OutputPair.TempVar->GetVariablePin(), RefPin);
+	}
 
-			// return
-			bIsErrorFree &= Schema->TryCreateConnection(AssignNode->GetValuePin(), ValuePin);
-			AssignNode->NotifyPinConnectionListChanged(AssignNode->GetValuePin());
+	// move connection from outside to vararg
+	UEdGraphPin* const ValuePin = CallNode->CreatePin(EGPD_Output, PinType, VariadicPropertyName);
+	return CompilerContext.MovePinLinksToIntermediate(*OutputPair.OutputPin, *ValuePin).CanSafeConnect();
+}
 
-			// exec
-			bIsErrorFree &= Schema->TryCreateConnection(InOutLastThenPin, AssignNode->GetExecPin());
-			InOutLastThenPin = AssignNode->GetThenPin();
-		}
-		else
-		{
-			// move connection from outside to vararg
-			bIsErrorFree &= CompilerContext.MovePinLinksToIntermediate(*OutputPair.OutputPin, *ValuePin).CanSafeConnect();
-		}
+bool UK2Node_EnhancedAsyncTaskBase::HandleGetActionCapturesIndexed(
+	const TArray<FOutputPinInfo>& InCaptureOutputs, UEdGraphPin* ActionPin, UEdGraphPin*& InOutLastThenPin,
+	UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph,
+	bool bConsume)
+{
+	bool bIsErrorFree = true;
+
+	TArray<FOutputPinInfo> CaptureOutputs;
+	bIsErrorFree &= HandleConstantCaptures(InCaptureOutputs, CaptureOutputs, InOutLastThenPin, Self, Schema, CompilerContext, SourceGraph);
+
+	if (CaptureOutputs.Num() == 0)
+	{ // there are no outputs, can safely skip
+		return bIsErrorFree;
+	}
+
+	// Variadic values are written in ascending capture index order
+	CaptureOutputs.Sort([](const FOutputPinInfo& A, const FOutputPinInfo& B) { return A.CaptureIndex < B.CaptureIndex; });
+
+	UK2Node_CallFunction* const CallGetVariadic = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(Self, SourceGraph);
+	CallGetVariadic->FunctionReference.SetExternalMember(
+		bConsume
+			? GET_MEMBER_NAME_CHECKED(UEnhancedAsyncContextLibrary, Action_ConsumeValue_Indexed)
+			: GET_MEMBER_NAME_CHECKED(UEnhancedAsyncContextLibrary, Action_GetValue_Indexed),
+		UEnhancedAsyncContextLibrary::StaticClass()
+	);
+	CallGetVariadic->AllocateDefaultPins();
+
+	// Bake the capture indices into single literal
+	Schema->TrySetDefaultValue(*CallGetVariadic->FindPinChecked(TEXT("Captures")), FString::FromInt(MakeCaptureMask(CaptureOutputs)));
+
+	bIsErrorFree &= Schema->TryCreateConnection(ActionPin, CallGetVariadic->FindPinChecked(EAA::Internals::PIN_Action));
+
+	bIsErrorFree &= Schema->TryCreateConnection(InOutLastThenPin, CallGetVariadic->GetExecPin());
+	InOutLastThenPin = CallGetVariadic->GetThenPin();
+
+	for (const FOutputPinInfo& OutputPair : CaptureOutputs)
+	{
+		bIsErrorFree &= CreateCaptureReadPin(CallGetVariadic, OutputPair, Schema, CompilerContext);
 	}
 
 	return bIsErrorFree;
@@ -1060,10 +1210,15 @@ void UK2Node_EnhancedAsyncTaskBase::ExpandNode(class FKismetCompilerContext& Com
 	bIsErrorFree &= Schema->TryCreateConnection(LastThenPin, ValidateProxyNode->GetExecPin());
 	LastThenPin = ValidateProxyNode->GetThenPin();
 
+	// one call creates context and writes captures, otherwise create, setup and set chain is used
+	const bool bFusedCreate = EAA::Switches::bFusedContextCreate && EAA::Switches::bVariadicGetSet;
+
 	// Create a call to context creation function and obtain handle
 	UK2Node_CallFunction* const CallCreateCaptureNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
 	CallCreateCaptureNode->FunctionReference.SetExternalMember(
-		GET_MEMBER_NAME_CHECKED(UEnhancedAsyncContextLibrary, CreateContextForObject),
+		bFusedCreate
+			? GET_MEMBER_NAME_CHECKED(UEnhancedAsyncContextLibrary, CreateContextForObjectIndexed)
+			: GET_MEMBER_NAME_CHECKED(UEnhancedAsyncContextLibrary, CreateContextForObject),
 		UEnhancedAsyncContextLibrary::StaticClass()
 	);
 	CallCreateCaptureNode->AllocateDefaultPins();
@@ -1089,11 +1244,19 @@ void UK2Node_EnhancedAsyncTaskBase::ExpandNode(class FKismetCompilerContext& Com
 		HandleSetupContext(CaptureContextHandlePin, LastThenPin, BuildContextConfigString(), this, Schema, CompilerContext, SourceGraph);
 	}
 
+	const bool bAllowConstantCaptures = AllowsConstantCaptures();
+
 	TArray<FInputPinInfo> CaptureInputs;
+	TMap<int32, UEdGraphPin*> ConstantCaptures;
 	ForEachCapturePin(EGPD_Input, [&](int32 Index, UEdGraphPin* InputPin)
 	{
 		const bool bInUse = !EAA::Internals::IsWildcardType(InputPin->PinType);
-		if (bInUse)
+		UEdGraphPin* const ConstantSource = bInUse && bAllowConstantCaptures ? FindConstantCaptureSource(InputPin) : nullptr;
+		if (ConstantSource)
+		{
+			ConstantCaptures.Add(Index, ConstantSource);
+		}
+		else if (bInUse)
 		{
 			FInputPinInfo& Info = CaptureInputs.AddDefaulted_GetRef();
 			Info.CaptureIndex = Index;
@@ -1103,13 +1266,17 @@ void UK2Node_EnhancedAsyncTaskBase::ExpandNode(class FKismetCompilerContext& Com
 	});
 
 	// Create capture setters
-	if (EAA::Switches::bVariadicGetSet)
+	if (bFusedCreate)
+	{
+		bIsErrorFree &= HandleVariadicCaptureInputs(CaptureInputs, CallCreateCaptureNode, this, Schema, CompilerContext, SourceGraph);
+	}
+	else if (EAA::Switches::bVariadicGetSet)
 	{
 		bIsErrorFree &= HandleSetContextDataVariadic(CaptureInputs, CaptureContextHandlePin, LastThenPin, this, Schema, CompilerContext, SourceGraph);
 	}
 	else
 	{
-		bIsErrorFree &= HandleSetContextData(CaptureInputs, CaptureContextHandlePin, LastThenPin, this, Schema, CompilerContext, SourceGraph);
+		bIsErrorFree &= HandleSetContextData(CaptureInputs, CaptureContextHandlePin, LastThenPin, this, Schema, CompilerContext, SourceGraph, bContextSetupRequired);
 	}
 
 	UEdGraphPin* OutputAsyncTaskProxy = FindPin(FBaseAsyncTaskHelper::GetAsyncTaskProxyName());
@@ -1122,7 +1289,7 @@ void UK2Node_EnhancedAsyncTaskBase::ExpandNode(class FKismetCompilerContext& Com
 	//		AND READ CONTEXT
 	//		AND IMPLEMENT A CHAIN OF ASSIGMENTS
 	UEdGraphPin * const PrevPin = LastThenPin;
-	bIsErrorFree &= HandleActionDelegates(CallCreateProxyObjectNode, LastThenPin, Schema, SourceGraph, CompilerContext);
+	bIsErrorFree &= HandleActionDelegates(CallCreateProxyObjectNode, LastThenPin, ConstantCaptures, Schema, SourceGraph, CompilerContext);
 
 	if (PrevPin == LastThenPin)
 	{
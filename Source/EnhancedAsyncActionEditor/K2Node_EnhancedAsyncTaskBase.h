@@ -41,6 +41,8 @@ public:
 	virtual void PostReconstructNode() override;
 
 	bool HasContextExposed() const;
+	// constant captures are not written into context when nothing else can read it by index
+	virtual bool AllowsConstantCaptures() const override { return !HasContextExposed(); }
 	bool IsContextPin(const UEdGraphPin* Pin) const;
 
 	FText ToggleContextPinStateLabel() const;
@@ -58,8 +60,19 @@ public:
 		int32 CaptureIndex = INDEX_NONE;
 		UEdGraphPin* OutputPin = nullptr;
 		UK2Node_TemporaryVariable* TempVar = nullptr;
+		// pin holding compile time value of the capture, it is assigned as literal and not stored in context
+		UEdGraphPin* ConstantSource = nullptr;
 	};
 
+	/**
+	 * Find pin holding compile time constant value of capture input: unlinked input itself or value of a linked literal node.
+	 *
+	 * @return null if capture value is only known at runtime
+	 */
+	static UEdGraphPin* FindConstantCaptureSource(UEdGraphPin* InputPin);
+	/** Literal assigned for constant capture, struct pins without default value get the struct default */
+	static ENHANCEDASYNCACTIONEDITOR_API FString GetConstantCaptureDefaultValue(const FEdGraphPinType& PinType, const FString& DefaultValue);
+
 	bool ValidateDelegates(
 	    const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph);
 
@@ -70,29 +83,52 @@ public:
 		UEdGraphPin* InContextHandlePin, UEdGraphPin*& InOutLastThenPin, FString Config,
 		UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph);
 
+	/** Emit setter per capture, staging is only emitted if captures were not declared by setup call */
 	static bool HandleSetContextData(
 		const TArray<FInputPinInfo>& CaptureInputs, UEdGraphPin* InContextHandlePin, UEdGraphPin*& InOutLastThenPin,
-		UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph);
+		UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph,
+		bool bContextSetUp);
 
 	static bool HandleSetContextDataVariadic(
 		const TArray<FInputPinInfo>& CaptureInputs, UEdGraphPin* InContextHandlePin, UEdGraphPin*& InOutLastThenPin,
 		UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph);
 
+	/** Bake capture mask and move capture inputs to variadic pins of indexed setter call */
+	static bool HandleVariadicCaptureInputs(
+		const TArray<FInputPinInfo>& CaptureInputs, class UK2Node_CallFunction* CallNode,
+		UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph);
+
 	bool HandleInvokeActivate(
 		UEdGraphPin* InProxyObjectPin, UEdGraphPin*& InOutLastThenPin,
 		const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph);
 
 	bool HandleActionDelegates(
-		class UK2Node_CallFunction* CallCreateProxyObjectNode, UEdGraphPin*& InOutLastThenPin,
+		class UK2Node_CallFunction* CallCreateProxyObjectNode, UEdGraphPin*& InOutLastThenPin, const TMap<int32, UEdGraphPin*>& ConstantCaptures,
 		const UEdGraphSchema_K2* Schema, UEdGraph* SourceGraph, FKismetCompilerContext& CompilerContext);
 
+	static bool HandleConstantCaptures(
+		const TArray<FOutputPinInfo>& CaptureOutputs, TArray<FOutputPinInfo>& OutContextOutputs, UEdGraphPin*& InOutLastThenPin,
+		UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph);
+
 	static bool HandleGetContextData(
 		const TArray<FOutputPinInfo>& CaptureOutputs, UEdGraphPin* ContextHandlePin, UEdGraphPin*& InOutLastThenPin,
 		UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph);
 
 	static bool HandleGetContextDataVariadic(
 		const TArray<FOutputPinInfo>& CaptureOutputs, UEdGraphPin* ContextHandlePin, UEdGraphPin*& InOutLastThenPin,
-		UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph);
+		UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph,
+		bool bConsume = false);
+
+	/** Add variadic pin of getter call for capture output, temporaries are written by reference and other outputs are moved to it */
+	static bool CreateCaptureReadPin(
+		class UK2Node_CallFunction* CallNode, const FOutputPinInfo& OutputPair,
+		const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext);
+
+	/** Find context of action and read captures into their temporaries by reference with single call */
+	static bool HandleGetActionCapturesIndexed(
+		const TArray<FOutputPinInfo>& CaptureOutputs, UEdGraphPin* ActionPin, UEdGraphPin*& InOutLastThenPin,
+		UK2Node* Self, const UEdGraphSchema_K2* Schema, FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph,
+		bool bConsume);
 
 	void OrphanCapturePins();
 
@@ -105,6 +141,9 @@ protected:
 	// marks context pin visible in graph
 	UPROPERTY()
 	bool bExposeContextParameter = false;
+	// action fires once, context is consumed by the read in event
+	UPROPERTY()
+	bool bConsumeContextOnRead = false;
 	// name of context container property, none for external
 	UPROPERTY()
 	FName AsyncContextContainerProperty;
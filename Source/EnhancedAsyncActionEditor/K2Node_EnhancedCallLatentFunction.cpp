@@ -11,7 +11,6 @@
 #include "K2Node_AssignmentStatement.h"
 #include "K2Node_CustomEvent.h"
 #include "K2Node_EnhancedAsyncTaskBase.h"
-#include "K2Node_MakeArray.h"
 #include "K2Node_Self.h"
 #include "K2Node_TemporaryVariable.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -386,13 +385,19 @@ void UK2Node_EnhancedCallLatentFunction::ExpandNode(class FKismetCompilerContext
 		bIsErrorFree &= UK2Node_EnhancedAsyncTaskBase::HandleSetupContext(LastContextPin, LastThenPin, BuildContextConfigString(), this, Schema, CompilerContext, SourceGraph);
 	}
 
+	TMap<int32, UEdGraphPin*> ConstantCaptures;
 	if (bContextRequired)
 	{ // create set context data variadic
 		TArray<FInputPinInfo> CaptureInputs;
 		ForEachCapturePin(EGPD_Input, [&](int32 Index, UEdGraphPin* InputPin)
 		{
 			const bool bInUse = !EAA::Internals::IsWildcardType(InputPin->PinType);
-			if (bInUse)
+			UEdGraphPin* const ConstantSource = bInUse && AllowsConstantCaptures() ? UK2Node_EnhancedAsyncTaskBase::FindConstantCaptureSource(InputPin) : nullptr;
+			if (ConstantSource)
+			{
+				ConstantCaptures.Add(Index, ConstantSource);
+			}
+			else if (bInUse)
 			{
 				FInputPinInfo& Info = CaptureInputs.AddDefaulted_GetRef();
 				Info.CaptureIndex = Index;
@@ -407,7 +412,7 @@ void UK2Node_EnhancedCallLatentFunction::ExpandNode(class FKismetCompilerContext
 		}
 		else
 		{
-			bIsErrorFree &= UK2Node_EnhancedAsyncTaskBase::HandleSetContextData(CaptureInputs, LastContextPin, LastThenPin, this, Schema, CompilerContext, SourceGraph);
+			bIsErrorFree &= UK2Node_EnhancedAsyncTaskBase::HandleSetContextData(CaptureInputs, LastContextPin, LastThenPin, this, Schema, CompilerContext, SourceGraph, bContextSetupRequired);
 		}
 	}
 
@@ -471,6 +476,7 @@ void UK2Node_EnhancedCallLatentFunction::ExpandNode(class FKismetCompilerContext
 				FOutputPinInfo& Info = CaptureOutputs.AddDefaulted_GetRef();
 				Info.CaptureIndex = Index;
 				Info.OutputPin = CurrentPin;
+				Info.ConstantSource = ConstantCaptures.FindRef(Index);
 			}
 			return true;
 		});
@@ -31,6 +31,7 @@ public:
 	virtual int32 GetNumCaptures() const override;
 	virtual const TArray<FEnhancedAsyncTaskCapture>& GetCapturesArray() const override;
 	virtual TArray<FEnhancedAsyncTaskCapture>& GetMutableCapturesArray() override;
+	virtual bool AllowsConstantCaptures() const override { return true; }
 
 	virtual void AllocateDefaultPins() override;
 	virtual bool CanSplitPin(const UEdGraphPin* Pin) const override;
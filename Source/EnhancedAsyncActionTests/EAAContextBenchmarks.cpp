@@ -0,0 +1,440 @@
+﻿// Copyright 2025, Aquanox.
+
+#include "CoreMinimal.h"
+#include "EAATestsShared.h"
+#include "EnhancedAsyncContext.h"
+#include "EnhancedAsyncActionHandle.h"
+#include "EnhancedAsyncContextImpl.h"
+#include "EnhancedAsyncContextLayout.h"
+#include "EnhancedAsyncContextLibrary.h"
+#include "EnhancedAsyncContextManager.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+/**
+ * Set of rooted owner objects for benchmarks that must not be collected during the run
+ */
+struct FBenchmarkOwners
+{
+	TArray<UObject*> Objects;
+
+	explicit FBenchmarkOwners(int32 Num)
+	{
+		Objects.Reserve(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			UObject* Object = NewObject<UBlueprintAsyncActionBase>();
+			Object->AddToRoot();
+			Objects.Add(Object);
+		}
+	}
+
+	~FBenchmarkOwners()
+	{
+		for (UObject* Object : Objects)
+		{
+			Object->RemoveFromRoot();
+		}
+	}
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAABenchmarkRegistryContention,
+	"EnhancedAsyncAction.Benchmark.RegistryContention",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
+
+bool FEAABenchmarkRegistryContention::RunTest(FString const&)
+{
+	constexpr int32 NumOwners = 4096;
+	constexpr int32 NumRounds = 16;
+	constexpr int32 NumLookups = 8;
+
+	FBenchmarkOwners Owners(NumOwners);
+	FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+
+	std::atomic<int32> NumFailures { 0 };
+
+	TArray<FAsyncContextId> Ids;
+	Ids.SetNum(NumOwners);
+
+	double Elapsed = 0.0;
+	for (int32 Round = 0; Round < NumRounds; ++Round)
+	{
+		// contexts are created on game thread, object reflection and pool are not thread safe
+		for (int32 Index = 0; Index < NumOwners; ++Index)
+		{
+			auto Result = Manager.CreateContext(Owners.Objects[Index], NAME_None);
+			Ids[Index] = Result.HasValue() ? Result.GetValue().GetId() : FAsyncContextId();
+			if (!Result.HasValue())
+			{
+				NumFailures.fetch_add(1);
+			}
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		// workers only touch the registry, each owns a distinct set of owners so every failure is a registry error rather than a test race
+		ParallelFor(NumOwners, [&](int32 Index)
+		{
+			const UObject* Owner = Owners.Objects[Index];
+			const FAsyncContextId Id = Ids[Index];
+			if (!Id.IsValid())
+			{
+				return;
+			}
+
+			for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup)
+			{
+				if (!Manager.FindContext(Id).IsValid() || !Manager.FindContextHandle(Owner).IsValid())
+				{
+					NumFailures.fetch_add(1);
+				}
+			}
+
+			if (Manager.DestroyContext(Id).GetValue() != 1)
+			{
+				NumFailures.fetch_add(1);
+			}
+		});
+
+		Elapsed += FPlatformTime::Seconds() - StartTime;
+
+		// contexts destroyed off game thread are released here
+		Manager.FlushDeferredReleases();
+	}
+
+	const int32 NumOperations = NumOwners * NumRounds * (1 + NumLookups * 2);
+
+	AddInfo(FString::Printf(TEXT("Registry: %d operations in %.3f ms (%.1f ns/op)"),
+		NumOperations, Elapsed * 1000.0, Elapsed * 1e9 / NumOperations));
+
+	XTEST_TRUE_EXPR(NumFailures.load() == 0);
+
+	for (const UObject* Owner : Owners.Objects)
+	{
+		XTEST_FALSE_EXPR(Manager.FindContextHandle(Owner).IsValid());
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAABenchmarkPurgeListener,
+	"EnhancedAsyncAction.Benchmark.PurgeListener",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
+
+bool FEAABenchmarkPurgeListener::RunTest(FString const&)
+{
+	constexpr int32 NumGarbage = 200000;
+	constexpr int32 NumContexts = 10000;
+
+	FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+
+	auto MeasurePurge = [NumGarbage]()
+	{
+		for (int32 Index = 0; Index < NumGarbage; ++Index)
+		{
+			NewObject<UBlueprintAsyncActionBase>();
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+		return FPlatformTime::Seconds() - StartTime;
+	};
+
+	// flush anything left from previous tests
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+	const double BaselineTime = MeasurePurge();
+
+	FBenchmarkOwners Owners(NumContexts);
+	for (const UObject* Owner : Owners.Objects)
+	{
+		XTEST_TRUE_EXPR(Manager.CreateContext(Owner, NAME_None).HasValue());
+	}
+
+	const double ListenerTime = MeasurePurge();
+
+	AddInfo(FString::Printf(TEXT("Purge of %d objects: %.3f ms without contexts, %.3f ms with %d live contexts"),
+		NumGarbage, BaselineTime * 1000.0, ListenerTime * 1000.0, NumContexts));
+
+	for (const UObject* Owner : Owners.Objects)
+	{
+		XTEST_TRUE_EXPR(Manager.FindContextHandle(Owner).IsValid());
+		Manager.DestroyContext(Manager.FindContextHandle(Owner).GetId());
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAABenchmarkReferenceCollection,
+	"EnhancedAsyncAction.Benchmark.ReferenceCollection",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
+
+bool FEAABenchmarkReferenceCollection::RunTest(FString const&)
+{
+	constexpr int32 NumContexts = 50000;
+	constexpr int32 NumRuns = 4;
+
+	IConsoleVariable* SkipVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("EnhancedAsyncAction.GC.SkipContextsWithoutReferences"));
+	XTEST_TRUE_EXPR(SkipVariable != nullptr);
+
+	FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+
+	FBenchmarkOwners Owners(NumContexts);
+	for (const UObject* Owner : Owners.Objects)
+	{
+		auto Result = Manager.CreateContext(Owner, NAME_None);
+		XTEST_TRUE_EXPR(Result.HasValue());
+		// plain data layout without object references
+		UEnhancedAsyncContextLibrary::SetupContextContainer(Result.GetValue(), TEXT("N:Int32;N:Float;N:String"));
+	}
+
+	auto MeasureCollect = [NumRuns]()
+	{
+		double Total = 0.0;
+		for (int32 Run = 0; Run < NumRuns; ++Run)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+			Total += FPlatformTime::Seconds() - StartTime;
+		}
+		return Total / NumRuns;
+	};
+
+	const bool bWasEnabled = SkipVariable->GetBool();
+
+	SkipVariable->Set(false);
+	const double VisitAllTime = MeasureCollect();
+
+	SkipVariable->Set(true);
+	const double SkipTime = MeasureCollect();
+
+	SkipVariable->Set(bWasEnabled);
+
+	AddInfo(FString::Printf(TEXT("Garbage collection with %d plain data contexts: %.3f ms visiting all, %.3f ms visiting referencing only"),
+		NumContexts, VisitAllTime * 1000.0, SkipTime * 1000.0));
+
+	for (const UObject* Owner : Owners.Objects)
+	{
+		Manager.DestroyContext(Manager.FindContextHandle(Owner).GetId());
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAABenchmarkHandleResolution,
+	"EnhancedAsyncAction.Benchmark.HandleResolution",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
+
+bool FEAABenchmarkHandleResolution::RunTest(FString const&)
+{
+	constexpr int32 NumContexts = 64;
+	constexpr int32 NumLookups = 100000;
+
+	FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+
+	FBenchmarkOwners Owners(NumContexts);
+	TArray<FEnhancedAsyncActionContextHandle> Handles;
+	for (const UObject* Owner : Owners.Objects)
+	{
+		auto Result = Manager.CreateContext(Owner, NAME_None);
+		XTEST_TRUE_EXPR(Result.HasValue());
+		Handles.Add(Result.GetValue());
+	}
+
+	int32 NumResolved = 0;
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup)
+	{
+		NumResolved += Manager.FindContext(Handles[Lookup % NumContexts]).IsValid() ? 1 : 0;
+	}
+	const double PinnedTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup)
+	{
+		NumResolved += Manager.FindContextOnGameThread(Handles[Lookup % NumContexts].GetId()) != nullptr ? 1 : 0;
+	}
+	const double GameThreadTime = FPlatformTime::Seconds() - StartTime;
+
+	AddInfo(FString::Printf(TEXT("Handle resolution: %.1f ns/op pinned, %.1f ns/op game thread"),
+		PinnedTime * 1e9 / NumLookups, GameThreadTime * 1e9 / NumLookups));
+
+	XTEST_TRUE_EXPR(NumResolved == NumLookups * 2);
+
+	for (const FEnhancedAsyncActionContextHandle& Handle : Handles)
+	{
+		Manager.DestroyContext(Handle.GetId());
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAABenchmarkSetupFromConfig,
+	"EnhancedAsyncAction.Benchmark.SetupFromConfig",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
+
+bool FEAABenchmarkSetupFromConfig::RunTest(FString const&)
+{
+	constexpr int32 NumCalls = 10000;
+
+	const FString Config = TEXT("N:Int32;N:Float;N:String;N:Name;A:Int32");
+
+	FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+
+	// config string parsed and bag struct resolved on every call
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Call = 0; Call < NumCalls; ++Call)
+	{
+		TArray<FPropertyBagPropertyDesc> Descs;
+		FEnhancedAsyncActionContext_PropertyBagBase::ParseStringDefinition(Config, Descs);
+
+		FInstancedPropertyBag Value;
+		Value.AddProperties(Descs);
+	}
+	const double ParseTime = FPlatformTime::Seconds() - StartTime;
+
+	// layout looked up by config string
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Call = 0; Call < NumCalls; ++Call)
+	{
+		bool bComplete;
+		FInstancedPropertyBag Value;
+		Value.InitializeFromBagStruct(FEnhancedAsyncContextLayout::FindOrAddDefinition(Config, bComplete));
+	}
+	const double CachedTime = FPlatformTime::Seconds() - StartTime;
+
+	// whole node path: create, setup, destroy
+	FBenchmarkOwners Owners(1);
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Call = 0; Call < NumCalls; ++Call)
+	{
+		auto Result = Manager.CreateContext(Owners.Objects[0], NAME_None);
+		UEnhancedAsyncContextLibrary::SetupContextContainer(Result.GetValue(), Config);
+		Manager.DestroyContext(Result.GetValue().GetId());
+	}
+	const double NodeTime = FPlatformTime::Seconds() - StartTime;
+
+	AddInfo(FString::Printf(TEXT("Setup from config: %.1f ns/call parsed, %.1f ns/call cached, %.1f ns/call create+setup+destroy"),
+		ParseTime * 1e9 / NumCalls, CachedTime * 1e9 / NumCalls, NodeTime * 1e9 / NumCalls));
+
+	bool bComplete = false;
+	XTEST_TRUE_EXPR(FEnhancedAsyncContextLayout::FindOrAddDefinition(Config, bComplete) != nullptr);
+	XTEST_TRUE_EXPR(bComplete);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAABenchmarkInlineContext,
+	"EnhancedAsyncAction.Benchmark.InlineContext",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
+
+bool FEAABenchmarkInlineContext::RunTest(FString const&)
+{
+	constexpr int32 NumCalls = 10000;
+
+	const FString Config = TEXT("N:Bool;N:Int32;N:Float;N:Name");
+
+	FBenchmarkOwners Owners(1);
+	const UObject* Owner = Owners.Objects[0];
+
+	bool bComplete;
+	const UPropertyBag* BagStruct = FEnhancedAsyncContextLayout::FindOrAddDefinition(Config, bComplete);
+	XTEST_TRUE_EXPR(BagStruct != nullptr && bComplete);
+
+	FEnhancedAsyncActionContext_Inline::FLayout Layout;
+	XTEST_TRUE_EXPR(Layout.Build(BagStruct->GetPropertyDescs()));
+
+	int64 Checksum = 0;
+
+	auto RunCalls = [&](TFunctionRef<TSharedRef<FEnhancedAsyncActionContext>()> Factory)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Call = 0; Call < NumCalls; ++Call)
+		{
+			TSharedRef<FEnhancedAsyncActionContext> Context = Factory();
+			Context->SetValueBool(0, true);
+			Context->SetValueInt32(1, Call);
+			Context->SetValueFloat(2, 1.f);
+			Context->SetValueName(3, NAME_Name);
+
+			int32 Value = 0;
+			Context->GetValueInt32(1, Value);
+			Checksum += Value;
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	};
+
+	const double BagTime = RunCalls([&]()
+	{
+		TSharedRef<FEnhancedAsyncActionContext> Context = MakeShared<FEnhancedAsyncActionContext_PropertyBag>(Owner);
+		Context->SetupFromStringDefinition(Config);
+		return Context;
+	});
+
+	const double InlineTime = RunCalls([&]()
+	{
+		return MakeShared<FEnhancedAsyncActionContext_Inline>(Owner, Layout);
+	});
+
+	AddInfo(FString::Printf(TEXT("Create+set+get+destroy: %.1f ns/call bag, %.1f ns/call inline"),
+		BagTime * 1e9 / NumCalls, InlineTime * 1e9 / NumCalls));
+
+	XTEST_TRUE_EXPR(Checksum == 2 * (int64(NumCalls) * (NumCalls - 1) / 2));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAABenchmarkVariadicAddressing,
+	"EnhancedAsyncAction.Benchmark.VariadicAddressing",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
+
+bool FEAABenchmarkVariadicAddressing::RunTest(FString const&)
+{
+	constexpr int32 NumCalls = 100000;
+
+	// per call argument work of variadic thunks: names array built by script and resolved back, or single baked mask
+	for (const int32 NumCaptures : { 1, 8, 16 })
+	{
+		TArray<FString> Literals;
+		uint32 BakedMask = 0;
+		for (int32 Index = 0; Index < NumCaptures; ++Index)
+		{
+			Literals.Add(EAA::Internals::IndexToName(Index).ToString());
+			BakedMask |= 1u << Index;
+		}
+
+		int64 NamesChecksum = 0;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Call = 0; Call < NumCalls; ++Call)
+		{
+			TArray<FString> Names = Literals;
+			for (const FString& Name : Names)
+			{
+				NamesChecksum += EAA::Internals::NameToIndex(FName(*Name));
+			}
+		}
+		const double NamesTime = FPlatformTime::Seconds() - StartTime;
+
+		int64 MaskChecksum = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Call = 0; Call < NumCalls; ++Call)
+		{
+			for (uint32 Mask = BakedMask; Mask; Mask &= Mask - 1)
+			{
+				MaskChecksum += FMath::CountTrailingZeros(Mask);
+			}
+		}
+		const double MaskTime = FPlatformTime::Seconds() - StartTime;
+
+		AddInfo(FString::Printf(TEXT("Variadic addressing of %d captures: %.1f ns/call names, %.1f ns/call mask"),
+			NumCaptures, NamesTime * 1e9 / NumCalls, MaskTime * 1e9 / NumCalls));
+
+		XTEST_TRUE_EXPR(NamesChecksum == MaskChecksum);
+	}
+
+	return true;
+}
@@ -6,14 +6,24 @@
 #include "EnhancedAsyncContextLibrary.h"
 #include "EnhancedAsyncContext.h"
 #include "EnhancedAsyncActionHandle.h"
+#include "EnhancedAsyncContextArena.h"
+#include "EnhancedAsyncContextShared.h"
+#include "EnhancedAsyncContextImpl.h"
 #include "StructUtils/InstancedStruct.h"
 #include "StructUtils/PropertyBag.h"
 #include "EnhancedAsyncContextManager.h"
+#include "EnhancedAsyncContextPool.h"
+#include "EnhancedAsyncContextSettings.h"
 #include "EAADemoAsyncAction.h"
 #include "EnhancedLatentActionHandle.h"
+#include "Async/ParallelFor.h"
 #include "Math/UnrealMathUtility.h"
 #include "Misc/AutomationTest.h"
 #include "Misc/AssertionMacros.h"
+#if WITH_EDITOR
+#include "EdGraphSchema_K2.h"
+#include "K2Node_EnhancedAsyncTaskBase.h"
+#endif
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestCreateAsync,
 	"EnhancedAsyncAction.Context.CreateAsync",
@@ -111,9 +121,713 @@ bool FEAALibraryTestCreateLatent::RunTest(FString const&)
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestStaleHandle,
+	"EnhancedAsyncAction.Context.StaleHandle",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestStaleHandle::RunTest(FString const&)
+{
+	FTestWorldScope Scope;
+
+	auto* World = Scope.World;
+
+	auto Handle = UEnhancedAsyncContextLibrary::CreateContextForLatent(World, 42, 142, true, FEnhancedLatentActionDelegate());
+	XTEST_TRUE_EXPR(Handle.GetContext().IsValid());
+
+	UEnhancedAsyncContextLibrary::DestroyContextForLatent(Handle);
+	XTEST_FALSE_EXPR(Handle.GetContext().IsValid());
+
+	// same call key reuses released slot, old handle must not resolve to the new context
+	auto NewHandle = UEnhancedAsyncContextLibrary::CreateContextForLatent(World, 42, 142, true, FEnhancedLatentActionDelegate());
+	XTEST_TRUE_EXPR(NewHandle.GetContext().IsValid());
+	XTEST_TRUE_EXPR(NewHandle.GetId().GetIndex() == Handle.GetId().GetIndex());
+	XTEST_TRUE_EXPR(NewHandle.GetId() != Handle.GetId());
+	XTEST_FALSE_EXPR(Handle.GetContext().IsValid());
+
+	UEnhancedAsyncContextLibrary::DestroyContextForLatent(NewHandle);
+	XTEST_FALSE_EXPR(NewHandle.GetContext().IsValid());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestGameThreadResolve,
+	"EnhancedAsyncAction.Context.GameThreadResolve",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestGameThreadResolve::RunTest(FString const&)
+{
+	FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+
+	FTestWorldScope Scope;
+
+	auto Handle = UEnhancedAsyncContextLibrary::CreateContextForLatent(Scope.World, 42, 142, true, FEnhancedLatentActionDelegate());
+	const FAsyncContextId Id = Handle.GetId();
+
+	// first call resolves through registry, second one hits the cache
+	FEnhancedAsyncActionContext* Context = Manager.FindContextOnGameThread(Id);
+	XTEST_TRUE_EXPR(Context != nullptr);
+	XTEST_TRUE_EXPR(Context == Manager.FindContext(Id).Get());
+	XTEST_TRUE_EXPR(Manager.FindContextOnGameThread(Id) == Context);
+
+	UEnhancedAsyncContextLibrary::DestroyContextForLatent(Handle);
+	XTEST_TRUE_EXPR(Manager.FindContextOnGameThread(Id) == nullptr);
+
+	// released slot is reused by the same call key, old identifier must stay stale
+	auto NewHandle = UEnhancedAsyncContextLibrary::CreateContextForLatent(Scope.World, 42, 142, true, FEnhancedLatentActionDelegate());
+	XTEST_TRUE_EXPR(Manager.FindContextOnGameThread(NewHandle.GetId()) != nullptr);
+	XTEST_TRUE_EXPR(Manager.FindContextOnGameThread(Id) == nullptr);
+
+	UEnhancedAsyncContextLibrary::DestroyContextForLatent(NewHandle);
+	XTEST_TRUE_EXPR(Manager.FindContextOnGameThread(NewHandle.GetId()) == nullptr);
+
+	// owner destroyed after first resolve, cached entry must not outlive it
+	auto* Owner = NewObject<UBlueprintAsyncActionBase>();
+	auto OwnerHandle = UEnhancedAsyncContextLibrary::CreateContextForObject(Owner, NAME_None);
+	XTEST_TRUE_EXPR(Manager.FindContextOnGameThread(OwnerHandle.GetId()) != nullptr);
+	Owner->MarkAsGarbage();
+	XTEST_TRUE_EXPR(Manager.FindContextOnGameThread(OwnerHandle.GetId()) == nullptr);
+	Manager.DestroyContext(OwnerHandle.GetId());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestActionResolve,
+	"EnhancedAsyncAction.Context.ActionResolve",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestActionResolve::RunTest(FString const&)
+{
+	FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+
+	FTestWorldScope Scope;
+
+	auto* Task = UEAADemoAsyncActionCapture::StartActionWithCapture(Scope.World, false, 42);
+
+	FAsyncContextId Id;
+	XTEST_TRUE_EXPR(Manager.FindContext(Task, Id) == nullptr);
+
+	// created instance is handed out and found by owner without building a handle
+	TSharedPtr<FEnhancedAsyncActionContext> Created;
+	auto Result = Manager.CreateContext(Task, NAME_None, Created);
+	XTEST_TRUE_EXPR(Result.HasValue());
+	XTEST_TRUE_EXPR(Created.IsValid());
+
+	TSharedPtr<FEnhancedAsyncActionContext> Found = Manager.FindContext(Task, Id);
+	XTEST_TRUE_EXPR(Found == Created);
+	XTEST_TRUE_EXPR(Id == Result.GetValue().GetId());
+
+	// game thread lookup by owner resolves through registry once, then hits the cache
+	FAsyncContextId GameThreadId;
+	XTEST_TRUE_EXPR(Manager.FindContextOnGameThread(Task, GameThreadId) == Created.Get());
+	XTEST_TRUE_EXPR(GameThreadId == Id);
+	GameThreadId = FAsyncContextId();
+	XTEST_TRUE_EXPR(Manager.FindContextOnGameThread(Task, GameThreadId) == Created.Get());
+	XTEST_TRUE_EXPR(GameThreadId == Id);
+
+	Manager.DestroyContext(Id);
+	XTEST_TRUE_EXPR(Manager.FindContext(Task, Id) == nullptr);
+	XTEST_TRUE_EXPR(Manager.FindContextOnGameThread(Task, GameThreadId) == nullptr);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestOwnerTeardown,
+	"EnhancedAsyncAction.Context.OwnerTeardown",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestOwnerTeardown::RunTest(FString const&)
+{
+	constexpr int32 NumCalls = 48;
+
+	FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+
+	UObject* Owner = NewObject<UBlueprintAsyncActionBase>();
+
+	TArray<FAsyncContextId> Ids;
+	for (int32 Call = 0; Call < NumCalls; ++Call)
+	{
+		auto Handle = UEnhancedAsyncContextLibrary::CreateContextForLatent(Owner, 1000 + Call, Call, true, FEnhancedLatentActionDelegate());
+		XTEST_TRUE_EXPR(Handle.GetContext().IsValid());
+		Ids.Add(Handle.GetId());
+	}
+
+	// unlink from head, middle and tail of owner list
+	XTEST_TRUE_EXPR(Manager.DestroyContext(Ids[NumCalls - 1]).GetValue() == 1);
+	XTEST_TRUE_EXPR(Manager.DestroyContext(Ids[NumCalls / 2]).GetValue() == 1);
+	XTEST_TRUE_EXPR(Manager.DestroyContext(Ids[0]).GetValue() == 1);
+	XTEST_TRUE_EXPR(Manager.FindContext(Ids[1]).IsValid());
+
+	// remaining contexts are released with their owner
+	Owner->MarkAsGarbage();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+
+	for (const FAsyncContextId& Id : Ids)
+	{
+		XTEST_TRUE_EXPR(Manager.DestroyContext(Id).GetValue() == 0);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestWorldPartition,
+	"EnhancedAsyncAction.Context.WorldPartition",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestWorldPartition::RunTest(FString const&)
+{
+	FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+
+	FTestWorldScope ScopeA;
+
+	auto HandleA = UEnhancedAsyncContextLibrary::CreateContextForObject(ScopeA.World);
+	XTEST_TRUE_EXPR(HandleA.GetContext().IsValid());
+
+	FAsyncContextId IdB;
+	{
+		FTestWorldScope ScopeB;
+
+		auto HandleB = UEnhancedAsyncContextLibrary::CreateContextForObject(ScopeB.World);
+		XTEST_TRUE_EXPR(HandleB.GetContext().IsValid());
+		XTEST_TRUE_EXPR(HandleA.GetId().GetIndex() != HandleB.GetId().GetIndex());
+		IdB = HandleB.GetId();
+	}
+
+	// cleanup of one world releases only its own contexts
+	XTEST_FALSE_EXPR(Manager.FindContext(IdB).IsValid());
+	XTEST_TRUE_EXPR(HandleA.GetContext().IsValid());
+
+	Manager.DestroyContext(HandleA.GetId());
+	XTEST_FALSE_EXPR(HandleA.GetContext().IsValid());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestContextPool,
+	"EnhancedAsyncAction.Context.Pool",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestContextPool::RunTest(FString const&)
+{
+	if (!FEnhancedAsyncContextPool::IsEnabled())
+	{
+		AddInfo(TEXT("Context pool is disabled in settings"));
+		return true;
+	}
+
+	FEnhancedAsyncContextPool& Pool = FEnhancedAsyncContextManager::Get().GetContextPool();
+	const FString Config = TEXT("N:Int32;N:String");
+
+	auto* Owner = NewObject<UBlueprintAsyncActionBase>();
+
+	{
+		auto Handle = UEnhancedAsyncContextLibrary::CreateContextForObject(Owner, NAME_None);
+		UEnhancedAsyncContextLibrary::SetupContextContainer(Handle, Config);
+		UEnhancedAsyncContextLibrary::Handle_SetValue_Int32(Handle, 0, 42);
+		UEnhancedAsyncContextLibrary::Handle_SetValue_String(Handle, 1, TEXT("foo"));
+		FEnhancedAsyncContextManager::Get().DestroyContext(Handle.GetId());
+	}
+
+	const FEnhancedAsyncContextPool::FStats Before = Pool.GetStats();
+
+	{
+		auto Handle = UEnhancedAsyncContextLibrary::CreateContextForObject(Owner, NAME_None);
+		UEnhancedAsyncContextLibrary::SetupContextContainer(Handle, Config);
+
+		const FEnhancedAsyncContextPool::FStats After = Pool.GetStats();
+		XTEST_TRUE_EXPR(After.ContextHits == Before.ContextHits + 1);
+		XTEST_TRUE_EXPR(After.ValueHits == Before.ValueHits + 1);
+
+		// recycled value must not leak data of previous call
+		int32 IntValue = -1;
+		FString StringValue;
+		UEnhancedAsyncContextLibrary::Handle_GetValue_Int32(Handle, 0, IntValue);
+		UEnhancedAsyncContextLibrary::Handle_GetValue_String(Handle, 1, StringValue);
+		XTEST_TRUE_EXPR(IntValue == 0);
+		XTEST_TRUE_EXPR(StringValue.IsEmpty());
+
+		FEnhancedAsyncContextManager::Get().DestroyContext(Handle.GetId());
+	}
+
+	return true;
+}
+
 #define PropertyIndexOf(InType) (static_cast<int32>(EPropertyBagPropertyType::InType))
 #define PropertyIndexOfContainer(InContainer, InType) (static_cast<int32>(EPropertyBagPropertyType::InType) | (static_cast<int32>(EPropertyBagContainerType::InContainer) << 16))
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestLayoutWarmUp,
+	"EnhancedAsyncAction.Context.LayoutWarmUp",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestLayoutWarmUp::RunTest(FString const&)
+{
+	if (!FEnhancedAsyncContextPool::IsEnabled())
+	{
+		AddInfo(TEXT("Context pool is disabled in settings"));
+		return true;
+	}
+
+	FEnhancedAsyncContextPool& Pool = FEnhancedAsyncContextManager::Get().GetContextPool();
+	const FString Config = TEXT("N:Int64;N:Name;A:Int32");
+
+	XTEST_TRUE_EXPR(Pool.WarmUpLayout(Config));
+	XTEST_FALSE_EXPR(Pool.WarmUpLayout(Config));
+	XTEST_TRUE_EXPR(Pool.FindLayout(Config) != nullptr);
+
+	const FEnhancedAsyncContextPool::FStats Before = Pool.GetStats();
+
+	// first call takes value built by warm-up
+	auto* Owner = NewObject<UBlueprintAsyncActionBase>();
+	auto Handle = UEnhancedAsyncContextLibrary::CreateContextForObject(Owner, NAME_None);
+	UEnhancedAsyncContextLibrary::SetupContextContainer(Handle, Config);
+
+	const FEnhancedAsyncContextPool::FStats After = Pool.GetStats();
+	XTEST_TRUE_EXPR(After.ValueHits == Before.ValueHits + 1);
+	XTEST_TRUE_EXPR(After.ValueMisses == Before.ValueMisses);
+
+	int64 Value = -1;
+	UEnhancedAsyncContextLibrary::Handle_SetValue_Int64(Handle, 0, 42);
+	UEnhancedAsyncContextLibrary::Handle_GetValue_Int64(Handle, 0, Value);
+	XTEST_TRUE_EXPR(Value == 42);
+
+	FEnhancedAsyncContextManager::Get().DestroyContext(Handle.GetId());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestInlineContext,
+	"EnhancedAsyncAction.Context.InlineContext",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestInlineContext::RunTest(FString const&)
+{
+	if (!FEnhancedAsyncActionContext_Inline::IsEnabled())
+	{
+		AddInfo(TEXT("Inline contexts are disabled in settings"));
+		return true;
+	}
+
+	FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+	using Lib = UEnhancedAsyncContextLibrary;
+
+	auto* Owner = NewObject<UBlueprintAsyncActionBase>();
+	auto Handle = Lib::CreateContextForObject(Owner, NAME_None);
+	Lib::SetupContextContainer(Handle, TEXT("N:Bool;N:Int32;N:Name"));
+
+	// plain data captures are moved to inline storage
+	XTEST_TRUE_EXPR(Manager.FindContext(Handle)->GetDebugName() == TEXT("FEnhancedAsyncActionContext_Inline"));
+
+	Lib::Handle_SetValue_Bool(Handle, 0, true);
+	Lib::Handle_SetValue_Int32(Handle, 1, 42);
+	Lib::Handle_SetValue_Name(Handle, 2, FName("foo"));
+
+	{ bool V = false; Lib::Handle_GetValue_Bool(Handle, 0, V); XTEST_TRUE_EXPR(V == true); }
+	{ int32 V = 0; Lib::Handle_GetValue_Int32(Handle, 1, V); XTEST_TRUE_EXPR(V == 42); }
+	{ FName V; Lib::Handle_GetValue_Name(Handle, 2, V); XTEST_TRUE_EXPR(V == FName("foo")); }
+
+	// miss leaves value untouched
+	{ int32 V = 7; Manager.FindContext(Handle)->GetValueInt32(5, V); XTEST_TRUE_EXPR(V == 7); }
+
+	// context does not outlive its owner
+	TSharedPtr<FEnhancedAsyncActionContext> InlineContext = Manager.FindContext(Handle);
+	XTEST_TRUE_EXPR(InlineContext->IsValid());
+	Owner->MarkAsGarbage();
+	XTEST_FALSE_EXPR(InlineContext->IsValid());
+	InlineContext.Reset();
+
+	XTEST_TRUE_EXPR(Manager.DestroyContext(Handle.GetId()).GetValue() == 1);
+
+	// captures that are not plain data stay in property bag
+	auto* OtherOwner = NewObject<UBlueprintAsyncActionBase>();
+	auto OtherHandle = Lib::CreateContextForObject(OtherOwner, NAME_None);
+	Lib::SetupContextContainer(OtherHandle, TEXT("N:Int32;N:String"));
+	XTEST_TRUE_EXPR(Manager.FindContext(OtherHandle)->GetDebugName() == TEXT("FEnhancedAsyncActionContext_PropertyBag"));
+
+	Manager.DestroyContext(OtherHandle.GetId());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestContextArena,
+	"EnhancedAsyncAction.Context.Arena",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestContextArena::RunTest(FString const&)
+{
+	FEnhancedAsyncContextArena Arena;
+
+	FEnhancedAsyncActionContext_Inline::FLayout Layout;
+	XTEST_TRUE_EXPR(Layout.Add(EAA::Internals::IndexToName(0), EPropertyBagContainerType::None, EPropertyBagPropertyType::Int32, nullptr));
+
+	auto* Owner = NewObject<UBlueprintAsyncActionBase>();
+
+	TArray<TSharedPtr<FEnhancedAsyncActionContext_Inline>> Contexts;
+	for (int32 Index = 0; Index < 8; ++Index)
+	{
+		Contexts.Add(FEnhancedAsyncContextArena::MakeContext<FEnhancedAsyncActionContext_Inline>(&Arena, Owner, Layout));
+	}
+
+	Contexts[3]->SetValueInt32(0, 42);
+	{ int32 V = 0; Contexts[3]->GetValueInt32(0, V); XTEST_TRUE_EXPR(V == 42); }
+
+	FEnhancedAsyncContextArena::FStats Stats = Arena.GetStats();
+	XTEST_TRUE_EXPR(Stats.NumAllocations == 8);
+	XTEST_TRUE_EXPR(Stats.NumLiveBlocks == 8);
+	XTEST_TRUE_EXPR(Stats.NumPages == 1);
+	XTEST_TRUE_EXPR(Stats.UsedBytes > 8 * (int64)sizeof(FEnhancedAsyncActionContext_Inline));
+
+	// released contexts reclaim the page in bulk
+	Contexts.Empty();
+	Stats = Arena.GetStats();
+	XTEST_TRUE_EXPR(Stats.NumLiveBlocks == 0);
+	XTEST_TRUE_EXPR(Stats.NumFallbacks == 0);
+
+	Arena.Trim();
+	XTEST_TRUE_EXPR(Arena.GetStats().CapacityBytes == 0);
+
+	// no arena means heap allocation
+	XTEST_TRUE_EXPR(FEnhancedAsyncContextArena::MakeContext<FEnhancedAsyncActionContext_Inline>(nullptr, Owner, Layout)->IsValid());
+
+	// contexts released from workers while their arena is torn down
+	{
+		TUniquePtr<FEnhancedAsyncContextArena> OwnedArena = MakeUnique<FEnhancedAsyncContextArena>();
+		for (int32 Index = 0; Index < 64; ++Index)
+		{
+			Contexts.Add(FEnhancedAsyncContextArena::MakeContext<FEnhancedAsyncActionContext_Inline>(OwnedArena.Get(), Owner, Layout));
+		}
+
+		ParallelFor(Contexts.Num() + 1, [&Contexts, &OwnedArena](int32 Index)
+		{
+			if (Index == Contexts.Num())
+			{
+				OwnedArena.Reset();
+			}
+			else
+			{
+				Contexts[Index].Reset();
+			}
+		});
+		Contexts.Empty();
+		XTEST_TRUE_EXPR(!OwnedArena.IsValid());
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestConsumeRead,
+	"EnhancedAsyncAction.Context.ConsumeRead",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestConsumeRead::RunTest(FString const&)
+{
+	FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+	using Lib = UEnhancedAsyncContextLibrary;
+
+	const FProperty* StringProperty = FindFProperty<FStrProperty>(FEAAContextTestStruct::StaticStruct(), TEXT("StringValue"));
+	XTEST_TRUE_EXPR(StringProperty != nullptr);
+
+	auto* Owner = NewObject<UBlueprintAsyncActionBase>();
+	auto Handle = Lib::CreateContextForObject(Owner, NAME_None);
+	Lib::SetupContextContainer(Handle, TEXT("N:Int32;N:String"));
+	Lib::Handle_SetValue_String(Handle, 1, FString(TEXT("payload")));
+
+	auto Context = Manager.FindContext(Handle);
+
+	// storage is moved out, context keeps the previous output value
+	FString Value;
+	XTEST_TRUE_EXPR(Context->ConsumeValueByIndex(1, StringProperty, &Value) == EContextAccessResult::Success);
+	XTEST_TRUE_EXPR(Value == TEXT("payload"));
+
+	FString Remaining;
+	Lib::Handle_GetValue_String(Handle, 1, Remaining);
+	XTEST_TRUE_EXPR(Remaining.IsEmpty());
+
+	Context.Reset();
+	Manager.DestroyContext(Handle.GetId());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestStaging,
+	"EnhancedAsyncAction.Context.Staging",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestStaging::RunTest(FString const&)
+{
+	using Lib = UEnhancedAsyncContextLibrary;
+
+	auto* Owner = NewObject<UBlueprintAsyncActionBase>();
+	auto Handle = Lib::CreateContextForObject(Owner, NAME_None);
+
+	Lib::BeginContextStaging(Handle);
+	Lib::Handle_SetValue_Int32(Handle, 0, 42);
+	Lib::Handle_SetValue_String(Handle, 1, FString(TEXT("foo")));
+	Lib::Handle_SetValue_Name(Handle, 2, FName("bar"));
+
+	Lib::CommitContextStaging(Handle);
+
+	{ int32 V = 0; Lib::Handle_GetValue_Int32(Handle, 0, V); XTEST_TRUE_EXPR(V == 42); }
+	{ FString V; Lib::Handle_GetValue_String(Handle, 1, V); XTEST_TRUE_EXPR(V == TEXT("foo")); }
+	{ FName V; Lib::Handle_GetValue_Name(Handle, 2, V); XTEST_TRUE_EXPR(V == FName("bar")); }
+
+	FEnhancedAsyncContextManager::Get().DestroyContext(Handle.GetId());
+
+	// reflected writes are copied aside, restaging capture with another type fails
+	const FProperty* IntegerProperty = FindFProperty<FIntProperty>(FEAAContextTestStruct::StaticStruct(), TEXT("IntegerValue"));
+	const FProperty* StringProperty = FindFProperty<FStrProperty>(FEAAContextTestStruct::StaticStruct(), TEXT("StringValue"));
+	XTEST_TRUE_EXPR(IntegerProperty != nullptr && StringProperty != nullptr);
+
+	auto OtherHandle = Lib::CreateContextForObject(NewObject<UBlueprintAsyncActionBase>(), NAME_None);
+	TSharedPtr<FEnhancedAsyncActionContext> Context = FEnhancedAsyncContextManager::Get().FindContext(OtherHandle);
+
+	int32 IntegerValue = 42;
+	FString StringValue = TEXT("foo");
+	Lib::BeginContextStaging(OtherHandle);
+	XTEST_TRUE_EXPR(Context->SetValueByIndex(0, IntegerProperty, &IntegerValue) == EContextAccessResult::Success);
+	XTEST_TRUE_EXPR(Context->SetValueByIndex(1, StringProperty, &StringValue) == EContextAccessResult::Success);
+	XTEST_TRUE_EXPR(Context->SetValueByIndex(0, StringProperty, &StringValue) == EContextAccessResult::IncompatibleType);
+	// staged copies do not alias the source
+	StringValue = TEXT("bar");
+	Lib::CommitContextStaging(OtherHandle);
+
+	{ int32 V = 0; XTEST_TRUE_EXPR(Context->GetValueByIndex(0, IntegerProperty, &V) == EContextAccessResult::Success); XTEST_TRUE_EXPR(V == 42); }
+	{ FString V; XTEST_TRUE_EXPR(Context->GetValueByIndex(1, StringProperty, &V) == EContextAccessResult::Success); XTEST_TRUE_EXPR(V == TEXT("foo")); }
+
+	Context.Reset();
+	FEnhancedAsyncContextManager::Get().DestroyContext(OtherHandle.GetId());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestSharedCapture,
+	"EnhancedAsyncAction.Context.SharedCapture",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestSharedCapture::RunTest(FString const&)
+{
+	if (!UEnhancedAsyncContextSettings::Get()->IsCaptureSharingEnabled())
+	{
+		AddInfo(TEXT("Capture sharing is disabled in settings"));
+		return true;
+	}
+
+	FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+	using Lib = UEnhancedAsyncContextLibrary;
+
+	const int32 NumPayloads = FEnhancedAsyncActionContext_PropertyBagBase::GetNumSharedCapturePayloads();
+	const TArray<int32> Source = { 1, 2, 3, 4 };
+	const TArray<int32> Alternate = { 4, 3, 2, 1 };
+
+	// interleaved values are shared each with its own payload
+	TArray<FEnhancedAsyncActionContextHandle> Handles;
+	for (int32 Index = 0; Index < 4; ++Index)
+	{
+		auto Handle = Lib::CreateContextForObject(NewObject<UBlueprintAsyncActionBase>(), NAME_None);
+		Lib::SetupContextContainer(Handle, TEXT("N:Int32;A:Int32"));
+		Lib::Handle_SetValue_Int32(Handle, 0, Index);
+		Manager.FindContext(Handle)->SetValueArray(1, EPropertyBagPropertyType::Int32, nullptr, Index % 2 ? &Alternate : &Source);
+		Handles.Add(Handle);
+	}
+	XTEST_TRUE_EXPR(FEnhancedAsyncActionContext_PropertyBagBase::GetNumSharedCapturePayloads() == NumPayloads + 2);
+
+	// contexts read the payload of their value
+	for (int32 Index = 0; Index < Handles.Num(); ++Index)
+	{
+		TStringBuilder<1024> Dump;
+		Manager.FindContext(Handles[Index])->DebugDump(Dump);
+		XTEST_TRUE_EXPR(FStringView(Dump).Contains(TEXT("shared payload")));
+
+		TArray<int32> Value;
+		Manager.FindContext(Handles[Index])->GetValueArray(1, EPropertyBagPropertyType::Int32, nullptr, &Value);
+		XTEST_TRUE_EXPR(Value == (Index % 2 ? Alternate : Source));
+	}
+
+	// overwritten capture gets its own copy, other context keeps the payload
+	const TArray<int32> Other = { 5 };
+	Manager.FindContext(Handles[0])->SetValueArray(1, EPropertyBagPropertyType::Int32, nullptr, &Other);
+	{
+		TArray<int32> Value;
+		Manager.FindContext(Handles[0])->GetValueArray(1, EPropertyBagPropertyType::Int32, nullptr, &Value);
+		XTEST_TRUE_EXPR(Value == Other);
+		Manager.FindContext(Handles[2])->GetValueArray(1, EPropertyBagPropertyType::Int32, nullptr, &Value);
+		XTEST_TRUE_EXPR(Value == Source);
+	}
+
+	for (const FEnhancedAsyncActionContextHandle& Handle : Handles)
+	{
+		Manager.DestroyContext(Handle.GetId());
+	}
+	Manager.FlushDeferredReleases();
+
+	// entries are pruned with their last context
+	XTEST_TRUE_EXPR(FEnhancedAsyncActionContext_PropertyBagBase::GetNumSharedCapturePayloads() == NumPayloads);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestStructView,
+	"EnhancedAsyncAction.Context.StructView",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestStructView::RunTest(FString const&)
+{
+	using Lib = UEnhancedAsyncContextLibrary;
+
+	auto* Owner = NewObject<UBlueprintAsyncActionBase>();
+	auto Handle = Lib::CreateContextForObject(Owner, NAME_None);
+
+	UScriptStruct* const StructType = StaticStruct<FEAACaptureContext>();
+	XTEST_TRUE_EXPR(!Lib::GetValueStructView(Handle, 0, StructType).IsValid());
+
+	const FEAACaptureContext StructValue { TEXT("foo"), 42, Owner };
+	FEnhancedAsyncContextManager::Get().FindContext(Handle)->SetValueStruct(0, StructType, reinterpret_cast<const uint8*>(&StructValue));
+
+	// view reads context memory in place
+	FConstStructView View = Lib::GetValueStructView(Handle, 0, StructType);
+	XTEST_TRUE_EXPR(View.IsValid());
+	XTEST_TRUE_EXPR(StructType->CompareScriptStruct(&StructValue, View.GetMemory(), PPF_None));
+	XTEST_TRUE_EXPR(View.GetMemory() == Lib::GetValueStructView(Handle, 0, StructType).GetMemory());
+
+	FEnhancedAsyncContextManager::Get().DestroyContext(Handle.GetId());
+
+	if (!UEnhancedAsyncContextSettings::Get()->IsCaptureSharingEnabled())
+	{
+		return true;
+	}
+
+	// views of contexts sharing a payload read the same immutable memory
+	UScriptStruct* const SharedType = StaticStruct<FEAASharedTestStruct>();
+	const FString Definition = FPropertyTypeInfo::EncodeTypeInfo(FPropertyTypeInfo(EPropertyBagPropertyType::Struct, SharedType));
+
+	FEAASharedTestStruct SharedValue;
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(SharedValue.Values); ++Index)
+	{
+		SharedValue.Values[Index] = Index;
+	}
+
+	TArray<FEnhancedAsyncActionContextHandle> Handles;
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		auto& SharedHandle = Handles.Add_GetRef(Lib::CreateContextForObject(NewObject<UBlueprintAsyncActionBase>(), NAME_None));
+		Lib::SetupContextContainer(SharedHandle, Definition);
+		FEnhancedAsyncContextManager::Get().FindContext(SharedHandle)->SetValueStruct(0, SharedType, reinterpret_cast<const uint8*>(&SharedValue));
+	}
+
+	FConstStructView SharedView = Lib::GetValueStructView(Handles[1], 0, SharedType);
+	XTEST_TRUE_EXPR(SharedView.IsValid());
+	XTEST_TRUE_EXPR(SharedView.GetMemory() == Lib::GetValueStructView(Handles[0], 0, SharedType).GetMemory());
+
+	// overwriting one context does not touch payload other context reads
+	FEAASharedTestStruct OtherValue = SharedValue;
+	OtherValue.Values[0] = -1;
+	FEnhancedAsyncContextManager::Get().FindContext(Handles[0])->SetValueStruct(0, SharedType, reinterpret_cast<const uint8*>(&OtherValue));
+	XTEST_TRUE_EXPR(SharedType->CompareScriptStruct(&OtherValue, Lib::GetValueStructView(Handles[0], 0, SharedType).GetMemory(), PPF_None));
+	XTEST_TRUE_EXPR(SharedView.GetMemory() == Lib::GetValueStructView(Handles[1], 0, SharedType).GetMemory());
+	XTEST_TRUE_EXPR(SharedType->CompareScriptStruct(&SharedValue, SharedView.GetMemory(), PPF_None));
+
+	for (const FEnhancedAsyncActionContextHandle& SharedHandle : Handles)
+	{
+		FEnhancedAsyncContextManager::Get().DestroyContext(SharedHandle.GetId());
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestMapCapture,
+	"EnhancedAsyncAction.Context.MapCapture",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestMapCapture::RunTest(FString const&)
+{
+	FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+
+	const FProperty* IntegerMapProperty = FindFProperty<FMapProperty>(FEAAContextTestStruct::StaticStruct(), TEXT("IntegerMap"));
+	const FProperty* StringMapProperty = FindFProperty<FMapProperty>(FEAAContextTestStruct::StaticStruct(), TEXT("StringMap"));
+	const FProperty* ByteMapProperty = FindFProperty<FMapProperty>(FEAAContextTestStruct::StaticStruct(), TEXT("ByteMap"));
+
+	// plain data maps are copied pair by pair as raw blocks, string keyed map goes through reflected copy
+	FEAAContextTestStruct Source;
+	for (int32 Index = 0; Index < 64; ++Index)
+	{
+		Source.IntegerMap.Add(Index * 7, Index);
+		Source.StringMap.Add(FString::FromInt(Index), Index);
+		Source.ByteMap.Add(static_cast<uint8>(Index * 3), static_cast<uint8>(Index));
+	}
+	Source.IntegerMap.Remove(14);
+	Source.ByteMap.Remove(9);
+
+	auto Handle = UEnhancedAsyncContextLibrary::CreateContextForObject(NewObject<UBlueprintAsyncActionBase>(), NAME_None);
+	TSharedPtr<FEnhancedAsyncActionContext> Context = Manager.FindContext(Handle);
+
+	XTEST_TRUE_EXPR(Context->SetValueByIndex(0, IntegerMapProperty, &Source.IntegerMap) == EContextAccessResult::Success);
+	XTEST_TRUE_EXPR(Context->SetValueByIndex(1, StringMapProperty, &Source.StringMap) == EContextAccessResult::Success);
+	XTEST_TRUE_EXPR(Context->SetValueByIndex(0, StringMapProperty, &Source.StringMap) == EContextAccessResult::IncompatibleType);
+	XTEST_TRUE_EXPR(Context->SetValueByIndex(2, ByteMapProperty, &Source.ByteMap) == EContextAccessResult::Success);
+
+	FEAAContextTestStruct Result;
+	XTEST_TRUE_EXPR(Context->GetValueByIndex(0, IntegerMapProperty, &Result.IntegerMap) == EContextAccessResult::Success);
+	XTEST_TRUE_EXPR(Context->GetValueByIndex(1, StringMapProperty, &Result.StringMap) == EContextAccessResult::Success);
+	XTEST_TRUE_EXPR(Result.IntegerMap.OrderIndependentCompareEqual(Source.IntegerMap));
+	XTEST_TRUE_EXPR(Result.StringMap.OrderIndependentCompareEqual(Source.StringMap));
+	// rebuilt hash stays usable for lookups and changes
+	XTEST_TRUE_EXPR(Result.IntegerMap.FindRef(21) == 3 && !Result.IntegerMap.Contains(14));
+	Result.IntegerMap.Add(14, 2);
+	XTEST_TRUE_EXPR(Result.IntegerMap.FindRef(14) == 2);
+
+	// packed pair of single byte key and value
+	XTEST_TRUE_EXPR(Context->GetValueByIndex(2, ByteMapProperty, &Result.ByteMap) == EContextAccessResult::Success);
+	XTEST_TRUE_EXPR(Result.ByteMap.OrderIndependentCompareEqual(Source.ByteMap));
+	XTEST_TRUE_EXPR(Result.ByteMap.FindRef(6) == 2 && !Result.ByteMap.Contains(9));
+
+	// consumed map is moved out
+	TMap<int32, int32> Consumed;
+	XTEST_TRUE_EXPR(Context->ConsumeValueByIndex(0, IntegerMapProperty, &Consumed) == EContextAccessResult::Success);
+	XTEST_TRUE_EXPR(Consumed.OrderIndependentCompareEqual(Source.IntegerMap));
+
+	Manager.DestroyContext(Handle.GetId());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestAccessResult,
+	"EnhancedAsyncAction.Context.AccessResult",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestAccessResult::RunTest(FString const&)
+{
+	FEnhancedAsyncContextManager& Manager = FEnhancedAsyncContextManager::Get();
+
+	const FProperty* IntegerProperty = FindFProperty<FIntProperty>(FEAAContextTestStruct::StaticStruct(), TEXT("IntegerValue"));
+	const FProperty* StringProperty = FindFProperty<FStrProperty>(FEAAContextTestStruct::StaticStruct(), TEXT("StringValue"));
+	XTEST_TRUE_EXPR(IntegerProperty != nullptr && StringProperty != nullptr);
+
+	auto Handle = UEnhancedAsyncContextLibrary::CreateContextForObject(NewObject<UBlueprintAsyncActionBase>(), NAME_None);
+	UEnhancedAsyncContextLibrary::SetupContextContainer(Handle, TEXT("N:Int32"));
+	TSharedPtr<FEnhancedAsyncActionContext> Context = Manager.FindContext(Handle);
+
+	int32 IntegerValue = 42;
+	FString StringValue;
+	XTEST_TRUE_EXPR(Context->SetValueByIndex(0, IntegerProperty, &IntegerValue) == EContextAccessResult::Success);
+	XTEST_TRUE_EXPR(Context->GetValueByIndex(0, StringProperty, &StringValue) == EContextAccessResult::IncompatibleType);
+	XTEST_TRUE_EXPR(Context->GetValueByIndex(3, IntegerProperty, &IntegerValue) == EContextAccessResult::UnknownProperty);
+	XTEST_TRUE_EXPR(Context->GetValueByIndex(0, IntegerProperty, nullptr) != EContextAccessResult::Success);
+
+	// counters are only advanced by reporting callers and only for failures
+	const FEnhancedAsyncActionContext::FAccessStats Before = FEnhancedAsyncActionContext::GetAccessStats();
+	FEnhancedAsyncActionContext::RecordAccessResult(EContextAccessResult::Success);
+	FEnhancedAsyncActionContext::RecordAccessResult(EContextAccessResult::IncompatibleType);
+	const FEnhancedAsyncActionContext::FAccessStats After = FEnhancedAsyncActionContext::GetAccessStats();
+	XTEST_TRUE_EXPR(After.Results[static_cast<int32>(EContextAccessResult::Success)] == 0);
+	XTEST_TRUE_EXPR(After.Results[static_cast<int32>(EContextAccessResult::IncompatibleType)] >= Before.Results[static_cast<int32>(EContextAccessResult::IncompatibleType)] + 1);
+	XTEST_TRUE_EXPR(After.GetNumFailures() >= Before.GetNumFailures() + 1);
+
+	const FString Description = FEnhancedAsyncActionContext::DescribeAccessResult(EContextAccessResult::IncompatibleType, TEXT("get"), 0, StringProperty);
+	XTEST_TRUE_EXPR(Description.Contains(TEXT("IncompatibleType")));
+
+	Manager.DestroyContext(Handle.GetId());
+
+	return true;
+}
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryOpsBasic,
 	"EnhancedAsyncAction.Context.Basic",
 	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
@@ -216,3 +930,37 @@ bool FEAALibraryOpsComplex::RunTest(FString const&)
 
 	return true;
 }
+
+#if WITH_EDITOR
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEAALibraryTestConstantCaptureDefault,
+	"EnhancedAsyncAction.Editor.ConstantCaptureDefault",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter | EAutomationTestFlags::HighPriority);
+
+bool FEAALibraryTestConstantCaptureDefault::RunTest(FString const&)
+{
+	UScriptStruct* const StructType = StaticStruct<FEAACaptureContext>();
+
+	FEdGraphPinType PinType;
+	PinType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+	PinType.PinSubCategoryObject = StructType;
+
+	// unlinked struct pin with empty default assigns the struct default
+	const FString Literal = UK2Node_EnhancedAsyncTaskBase::GetConstantCaptureDefaultValue(PinType, FString());
+	XTEST_TRUE_EXPR(!Literal.IsEmpty());
+
+	const FEAACaptureContext Default;
+	FEAACaptureContext Imported { TEXT("foo"), 42, nullptr };
+	XTEST_TRUE_EXPR(StructType->ImportText(*Literal, &Imported, nullptr, PPF_None, GLog, StructType->GetName()) != nullptr);
+	XTEST_TRUE_EXPR(StructType->CompareScriptStruct(&Imported, &Default, PPF_None));
+
+	// explicit defaults and other types are kept as is
+	const FString Explicit = TEXT("(ParamA=\"bar\",ParamB=7)");
+	XTEST_TRUE_EXPR(UK2Node_EnhancedAsyncTaskBase::GetConstantCaptureDefaultValue(PinType, Explicit) == Explicit);
+
+	PinType.PinCategory = UEdGraphSchema_K2::PC_Int;
+	PinType.PinSubCategoryObject = nullptr;
+	XTEST_TRUE_EXPR(UK2Node_EnhancedAsyncTaskBase::GetConstantCaptureDefaultValue(PinType, FString()).IsEmpty());
+
+	return true;
+}
+#endif
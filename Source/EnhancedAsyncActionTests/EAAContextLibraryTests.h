@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Misc/Crc.h"
 #include "EAAContextLibraryTests.generated.h"
 
 USTRUCT()
@@ -13,4 +14,25 @@ struct FEAAContextTestStruct
 	int32 IntegerValue;
 	UPROPERTY()
 	FString StringValue;
+	UPROPERTY()
+	TMap<int32, int32> IntegerMap;
+	UPROPERTY()
+	TMap<FString, int32> StringMap;
+	UPROPERTY()
+	TMap<uint8, uint8> ByteMap;
+};
+
+// Plain struct large enough for its captures to be shared
+USTRUCT()
+struct FEAASharedTestStruct
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Values[16];
+
+	friend uint32 GetTypeHash(const FEAASharedTestStruct& Value)
+	{
+		return FCrc::MemCrc32(Value.Values, sizeof(Value.Values));
+	}
 };
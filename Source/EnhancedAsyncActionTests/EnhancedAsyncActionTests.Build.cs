@@ -40,5 +40,17 @@ public class EnhancedAsyncActionTests : ModuleRules
 				"EnhancedAsyncAction"
 			}
 		);
+
+		// compile time helpers of editor nodes are tested as well
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(
+				new string[]
+				{
+					"BlueprintGraph",
+					"EnhancedAsyncActionEditor"
+				}
+			);
+		}
 	}
 }